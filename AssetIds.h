@@ -0,0 +1,360 @@
+// Generated by GenerateAssetIds.ps1 from the files under assets/. Don't
+// edit it by hand; the game's pre-build step regenerates it.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+enum class AssetFormat : std::uint8_t { Png, Jpeg, Gif, Wav, Mp3, Font, Other };
+
+enum class AssetId : std::uint16_t
+{
+    Background2Jpg,
+    ArialTtf,
+    AudioSuperMarioBrosMp3,
+    AudioCoinPng,
+    GoombaPng,
+    ImagesDryBoserzzzzzzzzzzPng,
+    ImagesGoombaTowerNsmb2Png,
+    ImagesMoonCoinPng,
+    ImagesNSMB2homePng,
+    ImagesNew10GoldCoinPng,
+    ImagesNewBlockGhostPng,
+    ImagesNewBlockGoldPng,
+    ImagesNewBlockGroundPng,
+    ImagesNewBlockUndergroundPng,
+    ImagesNewFireMarioPng,
+    ImagesNewGoldRingPng,
+    ImagesNewGoldRolettePng,
+    ImagesNewGoombaPng,
+    ImagesNewStoneBlockPng,
+    ImagesNewSuperLeafPng,
+    ImagesNewToadDoorPng,
+    ImagesNewTrampolinePng,
+    ImagesNewUrchinPng,
+    ImagesNewWhompPng,
+    ImagesPeepaNsmb2Png,
+    ImagesStarCoinNsmb2Png,
+    ImagesMarioPng,
+    ImagesTilesetPng,
+    MarioSoundsSmb1Up1Wav,
+    MarioSoundsSmb1UpWav,
+    MarioSoundsSmbBowserfallsWav,
+    MarioSoundsSmbBowserfireWav,
+    MarioSoundsSmbBreakblockWav,
+    MarioSoundsSmbBumpWav,
+    MarioSoundsSmbCoinWav,
+    MarioSoundsSmbFireballWav,
+    MarioSoundsSmbFireworksWav,
+    MarioSoundsSmbFlagpole1Wav,
+    MarioSoundsSmbFlagpoleWav,
+    MarioSoundsSmbGameoverWav,
+    MarioSoundsSmbJumpSmallWav,
+    MarioSoundsSmbJumpSuperWav,
+    MarioSoundsSmbKickWav,
+    MarioSoundsSmbMariodieWav,
+    MarioSoundsSmbPauseWav,
+    MarioSoundsSmbPipeWav,
+    MarioSoundsSmbPowerupWav,
+    MarioSoundsSmbPowerupAppearsWav,
+    MarioSoundsSmbStageClearWav,
+    MarioSoundsSmbStompWav,
+    MarioSoundsSmbVineWav,
+    MarioSoundsSmbWarningWav,
+    MarioSoundsSmbWorldClearWav,
+    MarioSpritesBackgroundBackground2Jpg,
+    MarioSpritesBackgroundSmwBackgrounds1Gif,
+    MarioSpritesBackgroundSmwBackgrounds3Gif,
+    MarioSpritesBackgroundSmwBackgrounds4Gif,
+    MarioSpritesBackgroundSmwBackgrounds6Gif,
+    MarioSpritesBackgroundMariosheetGif,
+    MarioSpritesBossesLarrySpriteSmasPng,
+    MarioSpritesBossesLudwigSpriteSMAllStarsPng,
+    MarioSpritesBossesSMASLemmyKoopaSpritePng,
+    MarioSpritesBossesSMASMortonKoopaJrSpritePng,
+    MarioSpritesBossesSMASRoyKoopaSpritePng,
+    MarioSpritesBossesSMASSMB3IggyKoopaSpritePng,
+    MarioSpritesBossesSMASWendyOKoopaSpritePng,
+    MarioSpritesBossesSmasBoomBoomPng,
+    MarioSpritesBossesSmasSmb3BowserSauteGif,
+    MarioSpritesEnemiesAngrySunPng,
+    MarioSpritesEnemiesBabyCheepPng,
+    MarioSpritesEnemiesBossBassSmb3Png,
+    MarioSpritesEnemiesBulletBillSmasSmb3Png,
+    MarioSpritesEnemiesFireChompSmb3Png,
+    MarioSpritesEnemiesGargantuaKoopaPng,
+    MarioSpritesEnemiesGiantParakoopasSmb3Png,
+    MarioSpritesEnemiesGoombaGif,
+    MarioSpritesEnemiesGrandGoombaPng,
+    MarioSpritesEnemiesKuriboShoePng,
+    MarioSpritesEnemiesMicroGoombaSmb3Png,
+    MarioSpritesEnemiesMissileBillSmb3Png,
+    MarioSpritesEnemiesNipperPlantPng,
+    MarioSpritesEnemiesPileDriverMicroGoombaPng,
+    MarioSpritesEnemiesPiranhacusPng,
+    MarioSpritesEnemiesSMASSMB3BooSpritePng,
+    MarioSpritesEnemiesSMASSMB3LakituSpritePng,
+    MarioSpritesEnemiesSmasSmb3SledgeBroSpritePng,
+    MarioSpritesInLevbelSmasSmb3FireMarioSpritePng,
+    MarioSpritesInLevbelSmasSmb3FrogMarioSpritePng,
+    MarioSpritesInLevbelSmasSmb3HammerMarioSpritePng,
+    MarioSpritesInLevbelSmasSmb3RaccoonMarioSpritePng,
+    MarioSpritesInLevbelSmasSmb3SmallMarioSpritePng,
+    MarioSpritesInLevbelSmasSmb3StatueMarioSpritePng,
+    MarioSpritesInLevbelSmasSmb3SuperLuigiSpritePng,
+    MarioSpritesInLevbelSmasSmb3SuperMarioSpritePng,
+    MarioSpritesInLevbelSmasSmb3TanookiMarioSpritePng,
+    MarioSpritesInLevbelSMASHammerSlidePng,
+    MarioSpritesItems1UpMushroomSmb3Png,
+    MarioSpritesItemsAnchorSMB3Png,
+    MarioSpritesItemsBall2Png,
+    MarioSpritesItemsChestPng,
+    MarioSpritesItemsFrogSuitPng,
+    MarioSpritesItemsGiantBlockPng,
+    MarioSpritesItemsHammerSuitSMB3Png,
+    MarioSpritesItemsIceblockPng,
+    MarioSpritesItemsMusicBoxSmb3Png,
+    MarioSpritesItemsPWingSMB3Png,
+    MarioSpritesItemsQuestionBlockGif,
+    MarioSpritesItemsReverseMushroomMbPng,
+    MarioSpritesItemsSmasSmb3SuperLeafPng,
+    MarioSpritesItemsSMASdoorPng,
+    MarioSpritesItemsSMB3GiantShellsPng,
+    MarioSpritesItemsSmb3CoinPng,
+    MarioSpritesItemsSuperMushroomSmasSmb3Png,
+    MarioSpritesItemsTanookiSuitSMB3Png,
+    MarioSpritesItemsWarpWhistlePng,
+    MarioSpritesItemsWoodenBlockPng,
+    MarioSpritesMapScreenAirforceGif,
+    MarioSpritesMapScreenAirshipGif,
+    MarioSpritesMapScreenBoomerangBroMapSmb3Png,
+    MarioSpritesMapScreenDesertGif,
+    MarioSpritesMapScreenFireBroMapSmb3Png,
+    MarioSpritesMapScreenFortress1Smb3Png,
+    MarioSpritesMapScreenFortress2Smb3Png,
+    MarioSpritesMapScreenHammerBroMapSmasSmb3Png,
+    MarioSpritesMapScreenNavyGif,
+    MarioSpritesMapScreenPyramidPng,
+    MarioSpritesMapScreenSmasSmb3FireMarioMapPng,
+    MarioSpritesMapScreenSmasSmb3FrogMarioMapPng,
+    MarioSpritesMapScreenSmasSmb3HammerMarioMapPng,
+    MarioSpritesMapScreenSmasSmb3PWingMarioMapPng,
+    MarioSpritesMapScreenSmasSmb3RaccoonMarioMapPng,
+    MarioSpritesMapScreenSmasSmb3SmallMarioMapPng,
+    MarioSpritesMapScreenSmasSmb3SuperLuigiMapPng,
+    MarioSpritesMapScreenSmasSmb3SuperMarioMapPng,
+    MarioSpritesMapScreenSmasSmb3TanookiMarioMapPng,
+    MarioSpritesMapScreenSMB3ToadHousesPng,
+    MarioSpritesMapScreenTankGif,
+    MarioSpritesMapScreenTanookiMarioMapSmassmb3Gif,
+    MarioSpritesMapScreenTowersmb3Png,
+    MarioSpritesMapScreenTreasureshipGif,
+    MarioSpritesMarioRestPng,
+    MarioSpritesMarioblocksPng,
+    MarioSpritesMariomoveBrickPng,
+    MarioSpritesMariomoveMariojumpPng,
+    MarioSpritesMariomoveMariojump1Png,
+    MarioSpritesMariomoveMariooverPng,
+    MarioSpritesMariomoveMariorightPng,
+    MarioSpritesMariomoveMariorunPng,
+    MarioSpritesMariomoveMariowalkPng,
+    MarioSpritesMariomoveMariowinPng,
+    MarioSpritesMariomoveMariowin2Png,
+    MarioSpritesMariomovementPng,
+    MarioSpritesMiniGameSmasSmb3RaccoonMarioGamePng,
+    MarioSpritesMiniGameSmasSmb3SmallMarioGamePng,
+    MarioSpritesMiniGameSmasSmb3SuperLuigiGamePng,
+    MarioSpritesMiniGameSmasSmb3SuperMarioGamePng,
+    MarioSpritesPrincessToddKingGrassLandKingCobratPng,
+    MarioSpritesPrincessToddKingSmasSmb3PrincessToadstoolLetterPng,
+    MarioSpritesPrincessToddKingSmasSmb3PrincessToadstoolSpritePng,
+    MarioSpritesPrincessToddKingSmasSmb3ToadGamePng,
+    MarioSpritesPrincessToddKingToadSMA3Png,
+    MarioPng,
+    Mariobackground2Png,
+    Mariobackground3Png,
+    MariobackgroundPng,
+    Count
+};
+
+struct AssetInfo
+{
+    const char* path;           // as on disk, case and all, from the working directory
+    AssetId blob;               // the asset whose file is loaded for these bytes
+    AssetFormat format;
+    std::uint16_t width;        // images only
+    std::uint16_t height;
+    std::uint32_t bytes;
+};
+
+// By AssetId.
+inline constexpr std::array<AssetInfo, static_cast<std::size_t>(AssetId::Count)> Assets{ {
+    { "assets/Background2.jpg", AssetId::Background2Jpg, AssetFormat::Jpeg, 1920, 1080, 154365 },
+    { "assets/arial.TTF", AssetId::ArialTtf, AssetFormat::Font, 0, 0, 1036584 },
+    { "assets/audio/SuperMarioBros.mp3", AssetId::AudioSuperMarioBrosMp3, AssetFormat::Mp3, 0, 0, 2954167 },
+    { "assets/audio/coin.png", AssetId::AudioCoinPng, AssetFormat::Png, 44, 44, 1679 },
+    { "assets/goomba.png", AssetId::GoombaPng, AssetFormat::Png, 23, 26, 1109 },
+    { "assets/images/Dry_Boserzzzzzzzzzz.png", AssetId::ImagesDryBoserzzzzzzzzzzPng, AssetFormat::Png, 217, 188, 16445 },
+    { "assets/images/Goomba_Tower_NSMB2.png", AssetId::ImagesGoombaTowerNsmb2Png, AssetFormat::Png, 29, 105, 2964 },
+    { "assets/images/MoonCoin.png", AssetId::ImagesMoonCoinPng, AssetFormat::Png, 42, 41, 1721 },
+    { "assets/images/NSMB2home.png", AssetId::ImagesNSMB2homePng, AssetFormat::Png, 74, 77, 4551 },
+    { "assets/images/New10GoldCoin.png", AssetId::ImagesNew10GoldCoinPng, AssetFormat::Png, 31, 32, 1615 },
+    { "assets/images/NewBlockGhost.png", AssetId::ImagesNewBlockGhostPng, AssetFormat::Png, 22, 22, 487 },
+    { "assets/images/NewBlockGold.png", AssetId::ImagesNewBlockGoldPng, AssetFormat::Png, 22, 22, 673 },
+    { "assets/images/NewBlockGround.png", AssetId::ImagesNewBlockGroundPng, AssetFormat::Png, 22, 22, 722 },
+    { "assets/images/NewBlockUnderground.png", AssetId::ImagesNewBlockUndergroundPng, AssetFormat::Png, 23, 22, 796 },
+    { "assets/images/NewFireMario.png", AssetId::ImagesNewFireMarioPng, AssetFormat::Png, 24, 42, 1482 },
+    { "assets/images/NewGoldRing.png", AssetId::ImagesNewGoldRingPng, AssetFormat::Png, 42, 57, 1299 },
+    { "assets/images/NewGoldRolette.png", AssetId::ImagesNewGoldRolettePng, AssetFormat::Png, 32, 32, 1247 },
+    { "assets/goomba.png", AssetId::GoombaPng, AssetFormat::Png, 23, 26, 1109 },    // assets/images/NewGoomba.png
+    { "assets/images/NewStoneBlock.png", AssetId::ImagesNewStoneBlockPng, AssetFormat::Png, 22, 22, 558 },
+    { "assets/images/NewSuperLeaf.png", AssetId::ImagesNewSuperLeafPng, AssetFormat::Png, 22, 26, 763 },
+    { "assets/images/NewToadDoor.png", AssetId::ImagesNewToadDoorPng, AssetFormat::Png, 44, 64, 2985 },
+    { "assets/images/NewTrampoline.png", AssetId::ImagesNewTrampolinePng, AssetFormat::Png, 23, 22, 887 },
+    { "assets/images/NewUrchin.png", AssetId::ImagesNewUrchinPng, AssetFormat::Png, 47, 47, 2032 },
+    { "assets/images/NewWhomp.png", AssetId::ImagesNewWhompPng, AssetFormat::Png, 69, 59, 3142 },
+    { "assets/images/Peepa!nsmb2.png", AssetId::ImagesPeepaNsmb2Png, AssetFormat::Png, 33, 33, 1104 },
+    { "assets/audio/coin.png", AssetId::AudioCoinPng, AssetFormat::Png, 44, 44, 1679 },    // assets/images/StarCoin___NSMB2.png
+    { "assets/images/mario.png", AssetId::ImagesMarioPng, AssetFormat::Png, 156, 216, 3530 },
+    { "assets/images/tileset.png", AssetId::ImagesTilesetPng, AssetFormat::Png, 250, 242, 89438 },
+    { "assets/mario sounds/smb_1-up.wav", AssetId::MarioSoundsSmb1UpWav, AssetFormat::Wav, 0, 0, 38426 },    // assets/mario sounds/smb_1-up (1).wav
+    { "assets/mario sounds/smb_1-up.wav", AssetId::MarioSoundsSmb1UpWav, AssetFormat::Wav, 0, 0, 38426 },
+    { "assets/mario sounds/smb_bowserfalls.wav", AssetId::MarioSoundsSmbBowserfallsWav, AssetFormat::Wav, 0, 0, 46466 },
+    { "assets/mario sounds/smb_bowserfire.wav", AssetId::MarioSoundsSmbBowserfireWav, AssetFormat::Wav, 0, 0, 51526 },
+    { "assets/mario sounds/smb_breakblock.wav", AssetId::MarioSoundsSmbBreakblockWav, AssetFormat::Wav, 0, 0, 25090 },
+    { "assets/mario sounds/smb_bump.wav", AssetId::MarioSoundsSmbBumpWav, AssetFormat::Wav, 0, 0, 10426 },
+    { "assets/mario sounds/smb_coin.wav", AssetId::MarioSoundsSmbCoinWav, AssetFormat::Wav, 0, 0, 42654 },
+    { "assets/mario sounds/smb_fireball.wav", AssetId::MarioSoundsSmbFireballWav, AssetFormat::Wav, 0, 0, 6756 },
+    { "assets/mario sounds/smb_fireworks.wav", AssetId::MarioSoundsSmbFireworksWav, AssetFormat::Wav, 0, 0, 19542 },
+    { "assets/mario sounds/smb_flagpole.wav", AssetId::MarioSoundsSmbFlagpoleWav, AssetFormat::Wav, 0, 0, 52622 },    // assets/mario sounds/smb_flagpole (1).wav
+    { "assets/mario sounds/smb_flagpole.wav", AssetId::MarioSoundsSmbFlagpoleWav, AssetFormat::Wav, 0, 0, 52622 },
+    { "assets/mario sounds/smb_gameover.wav", AssetId::MarioSoundsSmbGameoverWav, AssetFormat::Wav, 0, 0, 167408 },
+    { "assets/mario sounds/smb_jump-small.wav", AssetId::MarioSoundsSmbJumpSmallWav, AssetFormat::Wav, 0, 0, 26982 },
+    { "assets/mario sounds/smb_jump-super.wav", AssetId::MarioSoundsSmbJumpSuperWav, AssetFormat::Wav, 0, 0, 26712 },
+    { "assets/mario sounds/smb_kick.wav", AssetId::MarioSoundsSmbKickWav, AssetFormat::Wav, 0, 0, 8948 },
+    { "assets/mario sounds/smb_mariodie.wav", AssetId::MarioSoundsSmbMariodieWav, AssetFormat::Wav, 0, 0, 120570 },
+    { "assets/mario sounds/smb_pause.wav", AssetId::MarioSoundsSmbPauseWav, AssetFormat::Wav, 0, 0, 31174 },
+    { "assets/mario sounds/smb_pipe.wav", AssetId::MarioSoundsSmbPipeWav, AssetFormat::Wav, 0, 0, 35538 },
+    { "assets/mario sounds/smb_powerup.wav", AssetId::MarioSoundsSmbPowerupWav, AssetFormat::Wav, 0, 0, 44580 },
+    { "assets/mario sounds/smb_powerup_appears.wav", AssetId::MarioSoundsSmbPowerupAppearsWav, AssetFormat::Wav, 0, 0, 26728 },
+    { "assets/mario sounds/smb_stage_clear.wav", AssetId::MarioSoundsSmbStageClearWav, AssetFormat::Wav, 0, 0, 249748 },
+    { "assets/mario sounds/smb_stomp.wav", AssetId::MarioSoundsSmbStompWav, AssetFormat::Wav, 0, 0, 13070 },
+    { "assets/mario sounds/smb_vine.wav", AssetId::MarioSoundsSmbVineWav, AssetFormat::Wav, 0, 0, 52108 },
+    { "assets/mario sounds/smb_warning.wav", AssetId::MarioSoundsSmbWarningWav, AssetFormat::Wav, 0, 0, 130232 },
+    { "assets/mario sounds/smb_world_clear.wav", AssetId::MarioSoundsSmbWorldClearWav, AssetFormat::Wav, 0, 0, 277206 },
+    { "assets/Background2.jpg", AssetId::Background2Jpg, AssetFormat::Jpeg, 1920, 1080, 154365 },    // assets/mario sprites/background/Background2.jpg
+    { "assets/mario sprites/background/SMW-Backgrounds1.gif", AssetId::MarioSpritesBackgroundSmwBackgrounds1Gif, AssetFormat::Gif, 463, 1400, 145498 },
+    { "assets/mario sprites/background/SMW-Backgrounds3.gif", AssetId::MarioSpritesBackgroundSmwBackgrounds3Gif, AssetFormat::Gif, 463, 1425, 127770 },
+    { "assets/mario sprites/background/SMW-Backgrounds4.gif", AssetId::MarioSpritesBackgroundSmwBackgrounds4Gif, AssetFormat::Gif, 463, 1442, 179092 },
+    { "assets/mario sprites/background/SMW-Backgrounds6.gif", AssetId::MarioSpritesBackgroundSmwBackgrounds6Gif, AssetFormat::Gif, 463, 1407, 151104 },
+    { "assets/mario sprites/background/mariosheet.gif", AssetId::MarioSpritesBackgroundMariosheetGif, AssetFormat::Gif, 300, 910, 39933 },
+    { "assets/mario sprites/bosses/LarrySprite-SMAS.png", AssetId::MarioSpritesBossesLarrySpriteSmasPng, AssetFormat::Png, 28, 29, 529 },
+    { "assets/mario sprites/bosses/LudwigSprite-SMAllStars.png", AssetId::MarioSpritesBossesLudwigSpriteSMAllStarsPng, AssetFormat::Png, 33, 32, 471 },
+    { "assets/mario sprites/bosses/SMASLemmyKoopaSprite.png", AssetId::MarioSpritesBossesSMASLemmyKoopaSpritePng, AssetFormat::Png, 29, 48, 1053 },
+    { "assets/mario sprites/bosses/SMASMortonKoopaJr.Sprite.png", AssetId::MarioSpritesBossesSMASMortonKoopaJrSpritePng, AssetFormat::Png, 34, 32, 946 },
+    { "assets/mario sprites/bosses/SMASRoyKoopaSprite.png", AssetId::MarioSpritesBossesSMASRoyKoopaSpritePng, AssetFormat::Png, 34, 30, 913 },
+    { "assets/mario sprites/bosses/SMASSMB3IggyKoopaSprite.png", AssetId::MarioSpritesBossesSMASSMB3IggyKoopaSpritePng, AssetFormat::Png, 28, 32, 847 },
+    { "assets/mario sprites/bosses/SMASWendyO.KoopaSprite.png", AssetId::MarioSpritesBossesSMASWendyOKoopaSpritePng, AssetFormat::Png, 28, 32, 908 },
+    { "assets/mario sprites/bosses/SMAS_Boom_Boom.PNG", AssetId::MarioSpritesBossesSmasBoomBoomPng, AssetFormat::Png, 30, 28, 321 },
+    { "assets/mario sprites/bosses/Smas_smb3_bowser-saute.gif", AssetId::MarioSpritesBossesSmasSmb3BowserSauteGif, AssetFormat::Gif, 43, 53, 6443 },
+    { "assets/mario sprites/enemies/Angry_Sun.PNG", AssetId::MarioSpritesEnemiesAngrySunPng, AssetFormat::Png, 24, 24, 240 },
+    { "assets/mario sprites/enemies/Baby_Cheep.PNG", AssetId::MarioSpritesEnemiesBabyCheepPng, AssetFormat::Png, 12, 12, 171 },
+    { "assets/mario sprites/enemies/Boss_bass_smb3.png", AssetId::MarioSpritesEnemiesBossBassSmb3Png, AssetFormat::Png, 24, 32, 487 },
+    { "assets/mario sprites/enemies/BulletBill-SMAS-SMB3.png", AssetId::MarioSpritesEnemiesBulletBillSmasSmb3Png, AssetFormat::Png, 16, 14, 294 },
+    { "assets/mario sprites/enemies/Fire_chomp_smb3.png", AssetId::MarioSpritesEnemiesFireChompSmb3Png, AssetFormat::Png, 32, 36, 299 },
+    { "assets/mario sprites/enemies/Gargantua_koopa.PNG", AssetId::MarioSpritesEnemiesGargantuaKoopaPng, AssetFormat::Png, 53, 62, 543 },
+    { "assets/mario sprites/enemies/GiantParakoopas_SMB3.png", AssetId::MarioSpritesEnemiesGiantParakoopasSmb3Png, AssetFormat::Png, 24, 31, 318 },
+    { "assets/mario sprites/enemies/Goomba.gif", AssetId::MarioSpritesEnemiesGoombaGif, AssetFormat::Gif, 16, 16, 495 },
+    { "assets/mario sprites/enemies/Grand_Goomba.PNG", AssetId::MarioSpritesEnemiesGrandGoombaPng, AssetFormat::Png, 24, 23, 286 },
+    { "assets/mario sprites/enemies/Kuribo_Shoe.png", AssetId::MarioSpritesEnemiesKuriboShoePng, AssetFormat::Png, 16, 24, 235 },
+    { "assets/mario sprites/enemies/MicroGoomba_SMB3.png", AssetId::MarioSpritesEnemiesMicroGoombaSmb3Png, AssetFormat::Png, 8, 8, 135 },
+    { "assets/mario sprites/enemies/MissileBill_SMB3.png", AssetId::MarioSpritesEnemiesMissileBillSmb3Png, AssetFormat::Png, 16, 14, 328 },
+    { "assets/mario sprites/enemies/Nipper_Plant.PNG", AssetId::MarioSpritesEnemiesNipperPlantPng, AssetFormat::Png, 16, 16, 365 },
+    { "assets/mario sprites/enemies/PileDriverMicroGoomba.PNG", AssetId::MarioSpritesEnemiesPileDriverMicroGoombaPng, AssetFormat::Png, 16, 21, 199 },
+    { "assets/mario sprites/enemies/Piranhacus.png", AssetId::MarioSpritesEnemiesPiranhacusPng, AssetFormat::Png, 48, 79, 453 },
+    { "assets/mario sprites/enemies/SMASSMB3BooSprite.png", AssetId::MarioSpritesEnemiesSMASSMB3BooSpritePng, AssetFormat::Png, 16, 16, 198 },
+    { "assets/mario sprites/enemies/SMASSMB3LakituSprite.png", AssetId::MarioSpritesEnemiesSMASSMB3LakituSpritePng, AssetFormat::Png, 16, 30, 244 },
+    { "assets/mario sprites/enemies/SMAS_SMB3-SledgeBro_sprite.png", AssetId::MarioSpritesEnemiesSmasSmb3SledgeBroSpritePng, AssetFormat::Png, 32, 38, 380 },
+    { "assets/mario sprites/in-levbel/SMAS-SMB3-FireMarioSprite.png", AssetId::MarioSpritesInLevbelSmasSmb3FireMarioSpritePng, AssetFormat::Png, 14, 27, 302 },
+    { "assets/mario sprites/in-levbel/SMAS-SMB3-FrogMarioSprite.png", AssetId::MarioSpritesInLevbelSmasSmb3FrogMarioSpritePng, AssetFormat::Png, 20, 24, 266 },
+    { "assets/mario sprites/in-levbel/SMAS-SMB3-HammerMarioSprite.png", AssetId::MarioSpritesInLevbelSmasSmb3HammerMarioSpritePng, AssetFormat::Png, 16, 28, 335 },
+    { "assets/mario sprites/in-levbel/SMAS-SMB3-RaccoonMarioSprite.png", AssetId::MarioSpritesInLevbelSmasSmb3RaccoonMarioSpritePng, AssetFormat::Png, 21, 28, 352 },
+    { "assets/mario sprites/in-levbel/SMAS-SMB3-SmallMarioSprite.png", AssetId::MarioSpritesInLevbelSmasSmb3SmallMarioSpritePng, AssetFormat::Png, 12, 15, 233 },
+    { "assets/mario sprites/in-levbel/SMAS-SMB3-StatueMarioSprite.png", AssetId::MarioSpritesInLevbelSmasSmb3StatueMarioSpritePng, AssetFormat::Png, 16, 29, 271 },
+    { "assets/mario sprites/in-levbel/SMAS-SMB3-SuperLuigiSprite.png", AssetId::MarioSpritesInLevbelSmasSmb3SuperLuigiSpritePng, AssetFormat::Png, 14, 31, 318 },
+    { "assets/mario sprites/in-levbel/SMAS-SMB3-SuperMarioSprite.png", AssetId::MarioSpritesInLevbelSmasSmb3SuperMarioSpritePng, AssetFormat::Png, 14, 27, 307 },
+    { "assets/mario sprites/in-levbel/SMAS-SMB3-TanookiMarioSprite.png", AssetId::MarioSpritesInLevbelSmasSmb3TanookiMarioSpritePng, AssetFormat::Png, 21, 29, 325 },
+    { "assets/mario sprites/in-levbel/SMASHammerSlide.png", AssetId::MarioSpritesInLevbelSMASHammerSlidePng, AssetFormat::Png, 16, 27, 281 },
+    { "assets/mario sprites/items/1-up_mushroom_smb3.png", AssetId::MarioSpritesItems1UpMushroomSmb3Png, AssetFormat::Png, 16, 16, 194 },
+    { "assets/mario sprites/items/AnchorSMB3.png", AssetId::MarioSpritesItemsAnchorSMB3Png, AssetFormat::Png, 16, 16, 182 },
+    { "assets/mario sprites/items/Ball2.PNG", AssetId::MarioSpritesItemsBall2Png, AssetFormat::Png, 18, 18, 189 },
+    { "assets/mario sprites/items/Chest.PNG", AssetId::MarioSpritesItemsChestPng, AssetFormat::Png, 32, 32, 323 },
+    { "assets/mario sprites/items/FrogSuit.png", AssetId::MarioSpritesItemsFrogSuitPng, AssetFormat::Png, 16, 16, 189 },
+    { "assets/mario sprites/items/Giant_Block.PNG", AssetId::MarioSpritesItemsGiantBlockPng, AssetFormat::Png, 32, 32, 213 },
+    { "assets/mario sprites/items/HammerSuitSMB3.png", AssetId::MarioSpritesItemsHammerSuitSMB3Png, AssetFormat::Png, 14, 16, 199 },
+    { "assets/mario sprites/items/Iceblock.png", AssetId::MarioSpritesItemsIceblockPng, AssetFormat::Png, 16, 16, 221 },
+    { "assets/mario sprites/items/MusicBox_SMB3.png", AssetId::MarioSpritesItemsMusicBoxSmb3Png, AssetFormat::Png, 16, 16, 326 },
+    { "assets/mario sprites/items/PWingSMB3.png", AssetId::MarioSpritesItemsPWingSMB3Png, AssetFormat::Png, 14, 16, 172 },
+    { "assets/mario sprites/items/Question_Block.gif", AssetId::MarioSpritesItemsQuestionBlockGif, AssetFormat::Gif, 18, 18, 1368 },
+    { "assets/mario sprites/items/ReverseMushroom_MB.png", AssetId::MarioSpritesItemsReverseMushroomMbPng, AssetFormat::Png, 16, 16, 183 },
+    { "assets/mario sprites/items/SMAS-SMB3-SuperLeaf.png", AssetId::MarioSpritesItemsSmasSmb3SuperLeafPng, AssetFormat::Png, 36, 18, 218 },
+    { "assets/mario sprites/items/SMASdoor.png", AssetId::MarioSpritesItemsSMASdoorPng, AssetFormat::Png, 16, 32, 172 },
+    { "assets/mario sprites/items/SMB3GiantShells.png", AssetId::MarioSpritesItemsSMB3GiantShellsPng, AssetFormat::Png, 48, 22, 564 },
+    { "assets/mario sprites/items/SMB3_Coin.png", AssetId::MarioSpritesItemsSmb3CoinPng, AssetFormat::Png, 14, 16, 151 },
+    { "assets/mario sprites/items/SuperMushroom-SMAS-SMB3.png", AssetId::MarioSpritesItemsSuperMushroomSmasSmb3Png, AssetFormat::Png, 16, 16, 194 },
+    { "assets/mario sprites/items/TanookiSuitSMB3.png", AssetId::MarioSpritesItemsTanookiSuitSMB3Png, AssetFormat::Png, 16, 16, 202 },
+    { "assets/mario sprites/items/Warp_whistle.PNG", AssetId::MarioSpritesItemsWarpWhistlePng, AssetFormat::Png, 6, 16, 136 },
+    { "assets/mario sprites/items/Wooden_Block.PNG", AssetId::MarioSpritesItemsWoodenBlockPng, AssetFormat::Png, 32, 32, 272 },
+    { "assets/mario sprites/map screen/Airforce.gif", AssetId::MarioSpritesMapScreenAirforceGif, AssetFormat::Gif, 16, 16, 1395 },
+    { "assets/mario sprites/map screen/Airship.gif", AssetId::MarioSpritesMapScreenAirshipGif, AssetFormat::Gif, 16, 16, 212 },
+    { "assets/mario sprites/map screen/BoomerangBro-Map-SMB3.png", AssetId::MarioSpritesMapScreenBoomerangBroMapSmb3Png, AssetFormat::Png, 16, 16, 189 },
+    { "assets/mario sprites/map screen/Desert.gif", AssetId::MarioSpritesMapScreenDesertGif, AssetFormat::Gif, 16, 16, 326 },
+    { "assets/mario sprites/map screen/FireBro-Map-SMB3.png", AssetId::MarioSpritesMapScreenFireBroMapSmb3Png, AssetFormat::Png, 15, 16, 180 },
+    { "assets/mario sprites/map screen/Fortress1-SMB3.png", AssetId::MarioSpritesMapScreenFortress1Smb3Png, AssetFormat::Png, 16, 16, 187 },
+    { "assets/mario sprites/map screen/Fortress2-SMB3.png", AssetId::MarioSpritesMapScreenFortress2Smb3Png, AssetFormat::Png, 16, 16, 172 },
+    { "assets/mario sprites/map screen/HammerBro-Map-SMAS_SMB3.png", AssetId::MarioSpritesMapScreenHammerBroMapSmasSmb3Png, AssetFormat::Png, 16, 16, 190 },
+    { "assets/mario sprites/map screen/Navy.gif", AssetId::MarioSpritesMapScreenNavyGif, AssetFormat::Gif, 16, 16, 401 },
+    { "assets/mario sprites/map screen/Pyramid.png", AssetId::MarioSpritesMapScreenPyramidPng, AssetFormat::Png, 16, 16, 147 },
+    { "assets/mario sprites/map screen/SMAS-SMB3-FireMarioMap.png", AssetId::MarioSpritesMapScreenSmasSmb3FireMarioMapPng, AssetFormat::Png, 16, 21, 294 },
+    { "assets/mario sprites/map screen/SMAS-SMB3-FrogMarioMap.png", AssetId::MarioSpritesMapScreenSmasSmb3FrogMarioMapPng, AssetFormat::Png, 16, 20, 251 },
+    { "assets/mario sprites/map screen/SMAS-SMB3-HammerMarioMap.png", AssetId::MarioSpritesMapScreenSmasSmb3HammerMarioMapPng, AssetFormat::Png, 16, 21, 312 },
+    { "assets/mario sprites/map screen/SMAS-SMB3-PWingMarioMap.png", AssetId::MarioSpritesMapScreenSmasSmb3PWingMarioMapPng, AssetFormat::Png, 16, 24, 315 },
+    { "assets/mario sprites/map screen/SMAS-SMB3-RaccoonMarioMap.png", AssetId::MarioSpritesMapScreenSmasSmb3RaccoonMarioMapPng, AssetFormat::Png, 16, 24, 318 },
+    { "assets/mario sprites/map screen/SMAS-SMB3-SmallMarioMap.png", AssetId::MarioSpritesMapScreenSmasSmb3SmallMarioMapPng, AssetFormat::Png, 14, 16, 245 },
+    { "assets/mario sprites/map screen/SMAS-SMB3-SuperLuigiMap.png", AssetId::MarioSpritesMapScreenSmasSmb3SuperLuigiMapPng, AssetFormat::Png, 15, 24, 304 },
+    { "assets/mario sprites/map screen/SMAS-SMB3-SuperMarioMap.png", AssetId::MarioSpritesMapScreenSmasSmb3SuperMarioMapPng, AssetFormat::Png, 16, 21, 297 },
+    { "assets/mario sprites/map screen/SMAS-SMB3-TanookiMarioMap.png", AssetId::MarioSpritesMapScreenSmasSmb3TanookiMarioMapPng, AssetFormat::Png, 16, 23, 271 },
+    { "assets/mario sprites/map screen/SMB3ToadHouses.png", AssetId::MarioSpritesMapScreenSMB3ToadHousesPng, AssetFormat::Png, 50, 16, 345 },
+    { "assets/mario sprites/map screen/Tank.gif", AssetId::MarioSpritesMapScreenTankGif, AssetFormat::Gif, 16, 16, 345 },
+    { "assets/mario sprites/map screen/Tanooki_Mario_Map_SMASSMB3.gif", AssetId::MarioSpritesMapScreenTanookiMarioMapSmassmb3Gif, AssetFormat::Gif, 16, 24, 455 },
+    { "assets/mario sprites/map screen/Towersmb3.PNG", AssetId::MarioSpritesMapScreenTowersmb3Png, AssetFormat::Png, 16, 16, 175 },
+    { "assets/mario sprites/map screen/Treasureship.gif", AssetId::MarioSpritesMapScreenTreasureshipGif, AssetFormat::Gif, 16, 16, 150 },
+    { "assets/mario sprites/mario rest.png", AssetId::MarioSpritesMarioRestPng, AssetFormat::Png, 680, 764, 75778 },
+    { "assets/mario sprites/marioblocks.png", AssetId::MarioSpritesMarioblocksPng, AssetFormat::Png, 448, 256, 13083 },
+    { "assets/mario sprites/mariomove/brick.PNG", AssetId::MarioSpritesMariomoveBrickPng, AssetFormat::Png, 46, 67, 475 },
+    { "assets/mario sprites/mariomove/mariojump.PNG", AssetId::MarioSpritesMariomoveMariojumpPng, AssetFormat::Png, 41, 45, 4187 },
+    { "assets/mario sprites/mariomove/mariojump1.PNG", AssetId::MarioSpritesMariomoveMariojump1Png, AssetFormat::Png, 39, 41, 4307 },
+    { "assets/mario sprites/mariomove/marioover.PNG", AssetId::MarioSpritesMariomoveMariooverPng, AssetFormat::Png, 43, 45, 4392 },
+    { "assets/mario sprites/mariomove/marioright.PNG", AssetId::MarioSpritesMariomoveMariorightPng, AssetFormat::Png, 43, 44, 4573 },
+    { "assets/mario sprites/mariomove/mariorun.PNG", AssetId::MarioSpritesMariomoveMariorunPng, AssetFormat::Png, 44, 45, 4148 },
+    { "assets/mario sprites/mariomove/mariowalk.PNG", AssetId::MarioSpritesMariomoveMariowalkPng, AssetFormat::Png, 41, 45, 4819 },
+    { "assets/mario sprites/mariomove/mariowin.PNG", AssetId::MarioSpritesMariomoveMariowinPng, AssetFormat::Png, 44, 46, 4045 },
+    { "assets/mario sprites/mariomove/mariowin2.PNG", AssetId::MarioSpritesMariomoveMariowin2Png, AssetFormat::Png, 44, 44, 4197 },
+    { "assets/mario sprites/mariomovement.png", AssetId::MarioSpritesMariomovementPng, AssetFormat::Png, 584, 436, 50319 },
+    { "assets/mario sprites/mini game/SMAS-SMB3-RaccoonMarioGame.png", AssetId::MarioSpritesMiniGameSmasSmb3RaccoonMarioGamePng, AssetFormat::Png, 32, 61, 727 },
+    { "assets/mario sprites/mini game/SMAS-SMB3-SmallMarioGame.png", AssetId::MarioSpritesMiniGameSmasSmb3SmallMarioGamePng, AssetFormat::Png, 16, 29, 348 },
+    { "assets/mario sprites/mini game/SMAS-SMB3-SuperLuigiGame.png", AssetId::MarioSpritesMiniGameSmasSmb3SuperLuigiGamePng, AssetFormat::Png, 26, 64, 614 },
+    { "assets/mario sprites/mini game/SMAS-SMB3-SuperMarioGame.png", AssetId::MarioSpritesMiniGameSmasSmb3SuperMarioGamePng, AssetFormat::Png, 28, 61, 642 },
+    { "assets/mario sprites/princess todd king/GrassLandKing-cobrat.png", AssetId::MarioSpritesPrincessToddKingGrassLandKingCobratPng, AssetFormat::Png, 15, 36, 250 },
+    { "assets/mario sprites/princess todd king/SMAS-SMB3-PrincessToadstoolLetter.png", AssetId::MarioSpritesPrincessToddKingSmasSmb3PrincessToadstoolLetterPng, AssetFormat::Png, 30, 35, 415 },
+    { "assets/mario sprites/princess todd king/SMAS-SMB3-PrincessToadstoolSprite.png", AssetId::MarioSpritesPrincessToddKingSmasSmb3PrincessToadstoolSpritePng, AssetFormat::Png, 16, 30, 282 },
+    { "assets/mario sprites/princess todd king/SMAS-SMB3-ToadGame.png", AssetId::MarioSpritesPrincessToddKingSmasSmb3ToadGamePng, AssetFormat::Png, 30, 47, 848 },
+    { "assets/mario sprites/princess todd king/ToadSMA3.png", AssetId::MarioSpritesPrincessToddKingToadSMA3Png, AssetFormat::Png, 16, 27, 296 },
+    { "assets/mario.PNG", AssetId::MarioPng, AssetFormat::Png, 39, 44, 4546 },
+    { "assets/mariobackground-2.png", AssetId::Mariobackground2Png, AssetFormat::Png, 3072, 720, 30173 },
+    { "assets/mariobackground-3.png", AssetId::Mariobackground3Png, AssetFormat::Png, 2624, 240, 17816 },
+    { "assets/mariobackground.png", AssetId::MariobackgroundPng, AssetFormat::Png, 3376, 480, 26014 },
+} };
+
+constexpr const AssetInfo& asset(AssetId id) { return Assets[static_cast<std::size_t>(id)]; }
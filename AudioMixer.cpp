@@ -0,0 +1,64 @@
+#include "AudioMixer.h"
+
+#include <SFML/Audio/SoundChannel.hpp>
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
+#include <utility>
+
+AudioMixer::AudioMixer(unsigned int sampleRate, std::size_t maxVoices, std::size_t blockFrames) :
+    m_mixer(sampleRate, maxVoices),
+    m_block(blockFrames * 2)
+{
+    initialize(2, sampleRate, { sf::SoundChannel::FrontLeft, sf::SoundChannel::FrontRight });
+}
+
+AudioMixer::~AudioMixer()
+{
+    // SFML's thread calls onGetData until the stream stops; stop it while
+    // the mixer still exists
+    stop();
+}
+
+Mixer::SoundId AudioMixer::load(const sf::SoundBuffer& buffer)
+{
+    const std::int16_t* samples = buffer.getSamples();
+    const unsigned int channels = std::max(1u, buffer.getChannelCount());
+    const std::size_t frames = static_cast<std::size_t>(buffer.getSampleCount()) / channels;
+
+    // down to mono
+    std::vector<float> mono(frames);
+    for (std::size_t f = 0; f < frames; ++f)
+    {
+        float sum = 0.f;
+        for (unsigned int c = 0; c < channels; ++c)
+            sum += samples[f * channels + c];
+        mono[f] = sum / static_cast<float>(channels);
+    }
+
+    // to the mixer's rate, linearly; the sound effects already match it
+    const double ratio = static_cast<double>(buffer.getSampleRate()) / m_mixer.sampleRate();
+    const auto outFrames = frames == 0 ? 0 : static_cast<std::size_t>(static_cast<double>(frames) / ratio);
+    std::vector<std::int16_t> converted(outFrames);
+    for (std::size_t i = 0; i < outFrames; ++i)
+    {
+        const double position = static_cast<double>(i) * ratio;
+        const auto index = static_cast<std::size_t>(position);
+        const std::size_t next = std::min(index + 1, frames - 1);
+        const auto fraction = static_cast<float>(position - static_cast<double>(index));
+        const float value = mono[index] + (mono[next] - mono[index]) * fraction;
+        converted[i] = static_cast<std::int16_t>(std::clamp(value, -32768.f, 32767.f));
+    }
+    return m_mixer.addSound(std::move(converted));
+}
+
+bool AudioMixer::onGetData(Chunk& data)
+{
+    sf::Clock clock;
+    m_mixer.mix(m_block.data(), m_block.size() / 2);
+    m_blockMicroseconds.store(clock.getElapsedTime().asMicroseconds(), std::memory_order_relaxed);
+    m_blockVoices.store(m_mixer.activeVoices(), std::memory_order_relaxed);
+
+    data.samples = m_block.data();
+    data.sampleCount = m_block.size();
+    return true;        // never runs out, silence is just a block of zeros
+}
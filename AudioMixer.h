@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Mixer.h"
+
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Plays a Mixer through one sf::SoundStream: one hardware source for all
+// the game's sound, instead of one per sf::Sound. SFML pulls blocks from
+// its own streaming thread; each pull runs the mixer and is timed.
+class AudioMixer : public sf::SoundStream
+{
+public:
+    // 512 frames at 22050 Hz is 23 ms a block.
+    explicit AudioMixer(unsigned int sampleRate = 22050, std::size_t maxVoices = 64, std::size_t blockFrames = 512);
+    ~AudioMixer() override;
+
+    // Converts buffer to the mixer's format (mono, its sample rate) and adds
+    // it to the bank. Before play() only.
+    Mixer::SoundId load(const sf::SoundBuffer& buffer);
+
+    Mixer& mixer() { return m_mixer; }
+
+    // Cost of the last block, and the voices it mixed; safe from any thread.
+    std::int64_t lastBlockMicroseconds() const { return m_blockMicroseconds.load(std::memory_order_relaxed); }
+    std::size_t lastBlockVoices() const { return m_blockVoices.load(std::memory_order_relaxed); }
+
+private:
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time) override {}
+
+    Mixer m_mixer;
+    std::vector<std::int16_t> m_block;
+    std::atomic<std::int64_t> m_blockMicroseconds{ 0 };
+    std::atomic<std::size_t> m_blockVoices{ 0 };
+};
@@ -0,0 +1,344 @@
+#include "BattleServer.h"
+#include "BotClient.h"
+#include "NetProtocol.h"
+
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    // every world starts with the same enemies, so nobody gets an easier level
+    constexpr std::array<float, 5> StartingEnemies{ 600.f, 1200.f, 1800.f, 2400.f, 3000.f };
+}
+
+BattleServer::BattleServer(const BattleConfig& config) :
+    m_config(config),
+    m_pool(config.threads)
+{
+    m_slots.reserve(m_config.worldCount);
+    for (std::size_t i = 0; i < m_config.worldCount; ++i)
+        m_slots.emplace_back(freshWorld());
+}
+
+World BattleServer::freshWorld() const
+{
+    World world(m_config.spawn, m_config.levelWidth);
+    for (float x : StartingEnemies)
+        world.spawnEnemy(x, 0);
+    return world;
+}
+
+bool BattleServer::listen()
+{
+    if (m_socket.bind(m_config.port) != sf::Socket::Status::Done)
+    {
+        std::cerr << "Error: Failed to bind battle server to UDP port " << m_config.port << std::endl;
+        return false;
+    }
+    m_socket.setBlocking(false);
+
+    std::cout << "Battle server on UDP port " << m_config.port << ", " << m_slots.size() << " worlds, "
+              << m_pool.threadCount() << " threads" << std::endl;
+    return true;
+}
+
+void BattleServer::run(const std::atomic<bool>& running)
+{
+    const sf::Time tickTime = sf::seconds(TickSeconds);
+    sf::Clock clock;
+    sf::Time nextTick = clock.getElapsedTime();
+
+    while (running)
+    {
+        sf::Clock tickClock;
+
+        receive();
+
+        sf::Clock simulateClock;
+        simulate();
+        const float simulateMs = simulateClock.getElapsedTime().asSeconds() * 1000.f;
+
+        route();
+        broadcast();
+        ++m_tick;
+
+        const float tickMs = tickClock.getElapsedTime().asSeconds() * 1000.f;
+        ++m_ticksSinceReport;
+        m_simulateMsTotal += simulateMs;
+        m_simulateMsMax = std::max(m_simulateMsMax, simulateMs);
+        m_tickMsTotal += tickMs;
+        m_tickMsMax = std::max(m_tickMsMax, tickMs);
+        if (m_reportClock.getElapsedTime() >= sf::seconds(1.f))
+            report();
+
+        // Fixed rate: if a tick overran, start the next one right away rather
+        // than trying to catch up with a burst.
+        nextTick += tickTime;
+        const sf::Time now = clock.getElapsedTime();
+        if (nextTick > now)
+            sf::sleep(nextTick - now);
+        else
+            nextTick = now;
+    }
+}
+
+void BattleServer::benchmark(std::uint32_t ticks)
+{
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+        m_slots[i].client = Client{ sf::IpAddress::LocalHost, static_cast<unsigned short>(i), {} };
+
+    std::vector<float> simulateMs;
+    std::vector<float> tickMs;
+    simulateMs.reserve(ticks);
+    tickMs.reserve(ticks);
+    std::uint32_t replaced = 0;
+    for (std::uint32_t t = 0; t < ticks; ++t)
+    {
+        for (std::size_t i = 0; i < m_slots.size(); ++i)
+        {
+            Slot& s = m_slots[i];
+            if (!s.world.player().alive)
+            {
+                s.world = freshWorld();
+                s.previousInput = 0;
+                ++replaced;
+            }
+            s.input = botInput(i, t);
+        }
+
+        sf::Clock clock;
+        simulate();
+        simulateMs.push_back(clock.getElapsedTime().asSeconds() * 1000.f);
+        route();
+        tickMs.push_back(clock.getElapsedTime().asSeconds() * 1000.f);
+        ++m_tick;
+    }
+
+    auto print = [ticks](const char* label, std::vector<float>& ms)
+    {
+        double sum = 0.0;
+        for (float m : ms)
+            sum += m;
+        std::sort(ms.begin(), ms.end());
+        std::cout << "  " << std::left << std::setw(18) << label << std::right
+                  << " avg " << std::setw(7) << sum / std::max<std::uint32_t>(ticks, 1)
+                  << "  p99 " << std::setw(7) << ms[ms.size() * 99 / 100]
+                  << "  max " << std::setw(7) << ms.back() << " ms" << std::endl;
+    };
+    std::cout << std::fixed << std::setprecision(3)
+              << "Battle bench: " << m_slots.size() << " worlds, " << m_pool.threadCount() << " threads, "
+              << ticks << " ticks, " << replaced << " players replaced, budget " << TickSeconds * 1000.f << " ms" << std::endl;
+    if (ticks == 0)
+        return;
+    print("simulate", simulateMs);
+    print("simulate + route", tickMs);
+}
+
+void BattleServer::receive()
+{
+    sf::Packet packet;
+    std::optional<sf::IpAddress> address;
+    unsigned short port = 0;
+
+    while (m_socket.receive(packet, address, port) == sf::Socket::Status::Done)
+    {
+        ++m_packetsIn;
+        net::MessageType type{};
+        if (!address || !(packet >> type))
+            continue;
+
+        const std::optional<std::size_t> slot = findClient(*address, port);
+        switch (type)
+        {
+        case net::MessageType::Join:
+        {
+            std::optional<std::size_t> target = slot;
+            if (!target)
+            {
+                const auto free = std::find_if(m_slots.begin(), m_slots.end(), [](const Slot& s) { return !s.client; });
+                if (free != m_slots.end())
+                    target = static_cast<std::size_t>(free - m_slots.begin());
+            }
+
+            sf::Packet reply;
+            if (target)
+            {
+                Slot& s = m_slots[*target];
+                if (!s.client)
+                {
+                    s.world = freshWorld();
+                    s.input = s.previousInput = 0;
+                    s.inputTick.reset();
+                    s.inbox.clear();
+                    s.outbox.clear();
+                    s.client = Client{ *address, port, {} };
+                }
+                reply << net::MessageType::Welcome << static_cast<std::uint16_t>(*target) << m_tick;
+            }
+            else
+                reply << net::MessageType::Full;
+
+            if (m_socket.send(reply, *address, port) == sf::Socket::Status::Done)
+                ++m_packetsOut;
+            break;
+        }
+        case net::MessageType::Input:
+        {
+            std::uint32_t tick = 0;
+            std::uint16_t mask = 0;
+            if (slot && (packet >> tick >> mask))
+            {
+                // UDP can deliver late or out of order; a mask older than the one held is stale
+                Slot& s = m_slots[*slot];
+                if (!s.inputTick || tick >= *s.inputTick)
+                {
+                    s.input = mask;
+                    s.inputTick = tick;
+                }
+                s.client->sinceHeard.restart();
+            }
+            break;
+        }
+        case net::MessageType::Leave:
+            if (slot)
+                m_slots[*slot].client.reset();
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (Slot& s : m_slots)
+        if (s.client && s.client->sinceHeard.getElapsedTime() > sf::seconds(m_config.clientTimeoutSeconds))
+            s.client.reset();
+}
+
+void BattleServer::simulate()
+{
+    m_pool.parallelFor(m_slots.size(), [this](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            Slot& s = m_slots[i];
+            if (!s.client || !s.world.player().alive)
+                continue;
+
+            // enemies sent over by other players walk in from the far end
+            for (const EnemyState& enemy : s.inbox)
+                s.world.spawnEnemy(m_config.levelWidth - EnemyTypes[enemy.type].size.x - 1.f, enemy.type);
+            s.inbox.clear();
+
+            std::array<InputFrame, MaxPlayers> inputs{};
+            inputs[0] = InputFrame::fromMasks(s.input, s.previousInput);
+            s.previousInput = s.input;
+            s.world.step(inputs);
+
+            const std::vector<EnemyState>& defeated = s.world.defeatedThisTick();
+            s.outbox.insert(s.outbox.end(), defeated.begin(), defeated.end());
+        }
+    });
+}
+
+void BattleServer::route()
+{
+    const std::size_t count = m_slots.size();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Slot& from = m_slots[i];
+        if (from.outbox.empty())
+            continue;
+
+        // next player still standing, wrapping around
+        for (std::size_t step = 1; step < count; ++step)
+        {
+            Slot& to = m_slots[(i + step) % count];
+            if (to.client && to.world.player().alive)
+            {
+                to.inbox.insert(to.inbox.end(), from.outbox.begin(), from.outbox.end());
+                m_enemiesSent += from.outbox.size();
+                break;
+            }
+        }
+        from.outbox.clear();
+    }
+}
+
+void BattleServer::broadcast()
+{
+    const auto worldsLeft = static_cast<std::uint16_t>(aliveCount());
+
+    sf::Packet packet;
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        const Slot& s = m_slots[i];
+        if (!s.client)
+            continue;
+
+        net::PlayerSnapshot snapshot;
+        snapshot.tick = m_tick;
+        snapshot.world = static_cast<std::uint16_t>(i);
+        snapshot.position = s.world.player().position;
+        snapshot.velocity = s.world.player().velocity;
+        snapshot.alive = s.world.player().alive;
+        snapshot.worldsLeft = worldsLeft;
+
+        const EnemyStore& enemies = s.world.enemies();
+        const auto enemyCount = static_cast<std::uint16_t>(std::min<std::size_t>(enemies.size(), net::MaxEnemiesPerState));
+
+        packet.clear();
+        packet << net::MessageType::State << snapshot << enemyCount;
+        std::uint16_t written = 0;
+        for (std::size_t a = 0; a < EnemyArchetypeCount && written < enemyCount; ++a)
+        {
+            const EnemyStore::Batch& batch = enemies.batch(static_cast<EnemyArchetype>(a));
+            for (std::size_t e = 0; e < batch.size() && written < enemyCount; ++e, ++written)
+                packet << batch.type[e] << batch.x[e] << batch.y[e];
+        }
+
+        if (m_socket.send(packet, s.client->address, s.client->port) == sf::Socket::Status::Done)
+            ++m_packetsOut;
+    }
+}
+
+void BattleServer::report()
+{
+    const std::size_t occupied = static_cast<std::size_t>(
+        std::count_if(m_slots.begin(), m_slots.end(), [](const Slot& s) { return s.client.has_value(); }));
+    const float ticks = static_cast<float>(std::max<std::uint32_t>(1, m_ticksSinceReport));
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "tick " << m_tick << "  players " << occupied << " (" << aliveCount() << " alive)"
+              << "  simulate avg " << m_simulateMsTotal / ticks << " max " << m_simulateMsMax << " ms"
+              << "  tick avg " << m_tickMsTotal / ticks << " max " << m_tickMsMax << " ms"
+              << "  (" << m_ticksSinceReport << " Hz)"
+              << "  packets in " << m_packetsIn << " out " << m_packetsOut
+              << "  enemies sent " << m_enemiesSent << std::endl;
+
+    m_reportClock.restart();
+    m_ticksSinceReport = 0;
+    m_simulateMsTotal = m_simulateMsMax = 0.f;
+    m_tickMsTotal = m_tickMsMax = 0.f;
+    m_packetsIn = m_packetsOut = 0;
+}
+
+std::optional<std::size_t> BattleServer::findClient(const sf::IpAddress& address, unsigned short port) const
+{
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        const std::optional<Client>& client = m_slots[i].client;
+        if (client && client->port == port && client->address.toInteger() == address.toInteger())
+            return i;
+    }
+    return std::nullopt;
+}
+
+std::size_t BattleServer::aliveCount() const
+{
+    return static_cast<std::size_t>(std::count_if(m_slots.begin(), m_slots.end(),
+        [](const Slot& s) { return s.client && s.world.player().alive; }));
+}
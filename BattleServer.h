@@ -0,0 +1,102 @@
+#pragma once
+
+#include "NetProtocol.h"
+#include "ThreadPool.h"
+#include "World.h"
+
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Clock.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+struct BattleConfig
+{
+    std::size_t worldCount = 64;
+    std::size_t threads = 0;                // 0: one per hardware thread
+    unsigned short port = net::DefaultServerPort;
+    sf::Vector2f spawn{ 10.f, 371.f };      // same level for everybody
+    float levelWidth = 3376.f;
+    float clientTimeoutSeconds = 5.f;
+};
+
+// Battle mode server: one independent World per connected player, all
+// stepped at 60 Hz. Enemies a player stomps are sent on to the next
+// player still standing.
+//
+// A tick runs in four phases. Only simulate() is parallel. It gives each
+// pool thread a contiguous range of worlds, and a world's tick touches
+// nothing outside its own Slot, so the hot path needs no locks or atomics.
+// Traffic between worlds goes through each slot's outbox and inbox. The
+// serial route() phase moves enemies between them, between two simulate()
+// phases.
+class BattleServer
+{
+public:
+    explicit BattleServer(const BattleConfig& config);
+
+    bool listen();
+
+    // Runs the fixed-rate loop until running turns false.
+    void run(const std::atomic<bool>& running);
+
+    // supermario-server --battle-bench: fills every world with a player fed
+    // botInput() directly, with no sockets, and runs simulate() and route()
+    // back to back for ticks ticks. A player who dies is replaced by a new
+    // one outside the timing, so every world stays busy, unlike a real
+    // battle. Prints the per-tick cost against the 60 Hz budget.
+    void benchmark(std::uint32_t ticks);
+
+private:
+    struct Client
+    {
+        sf::IpAddress address;
+        unsigned short port;
+        sf::Clock sinceHeard;
+    };
+
+    // alignas keeps neighbouring slots, ticked by different threads, off each other's cache lines
+    struct alignas(64) Slot
+    {
+        explicit Slot(World world) : world(std::move(world)) {}
+
+        World world;
+        std::optional<Client> client;
+        std::uint16_t input = 0;            // latest held-actions mask from the client
+        std::optional<std::uint32_t> inputTick;     // client tick of that mask; older packets are dropped
+        std::uint16_t previousInput = 0;
+        std::vector<EnemyState> inbox;      // written by route(), read by this world's tick
+        std::vector<EnemyState> outbox;     // written by this world's tick, read by route()
+    };
+
+    World freshWorld() const;
+    void receive();
+    void simulate();
+    void route();
+    void broadcast();
+    void report();
+
+    std::optional<std::size_t> findClient(const sf::IpAddress& address, unsigned short port) const;
+    std::size_t aliveCount() const;
+
+    BattleConfig m_config;
+    ThreadPool m_pool;
+    sf::UdpSocket m_socket;
+    std::vector<Slot> m_slots;
+    std::uint32_t m_tick = 0;
+
+    // stats for the once-a-second report
+    sf::Clock m_reportClock;
+    std::uint32_t m_ticksSinceReport = 0;
+    float m_simulateMsTotal = 0.f;
+    float m_simulateMsMax = 0.f;
+    float m_tickMsTotal = 0.f;
+    float m_tickMsMax = 0.f;
+    std::uint64_t m_packetsIn = 0;
+    std::uint64_t m_packetsOut = 0;
+    std::uint64_t m_enemiesSent = 0;
+};
@@ -0,0 +1,252 @@
+#include "BossBenchmark.h"
+#include "BossScript.h"
+#include "Random.h"
+#include "World.h"
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    constexpr float GroundY = 371.f;
+    constexpr float ArenaLeft = 0.f;
+    constexpr float ArenaRight = 1024.f;
+    constexpr float AlertRange = 160.f;
+    constexpr sf::Vector2f Target{ 512.f, GroundY };
+    constexpr float HitChance = 1.f / 150.f;
+
+    Script patrolScript(ScriptContext& context)
+    {
+        BossActor& me = context.self();
+        me.health = 3;
+
+        while (me.health > 0)
+        {
+            me.facingRight = context.target().x > me.position.x;
+            me.velocity.x = me.facingRight ? 80.f : -80.f;
+            co_await context.ticks(60);
+            me.velocity.x = 0.f;
+
+            me.velocity.y = -500.f;
+            me.onGround = false;
+            co_await context.event(BossEvent::Landed, 180);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                context.attack(BossAttack::Kind::Fireball, { 200.f, 0.f });
+                co_await context.ticks(10);
+            }
+
+            if (co_await context.event(BossEvent::Hit, 90))
+            {
+                --me.health;
+                me.spinning = true;
+                co_await context.ticks(30);
+                me.spinning = false;
+            }
+        }
+    }
+
+    // The same pattern written the usual way. Every state that ends without
+    // waiting carries straight on into the next within the same tick, as the
+    // coroutine does.
+    struct PatrolMachine
+    {
+        enum class State : std::uint8_t { Start, Walk, Hop, Shoot, ShootWait, WaitForHit, Wait, Spin, Done };
+
+        State state = State::Start;
+        std::uint32_t timer = 0;
+        int shots = 0;
+    };
+
+    void updateMachine(PatrolMachine& m, BossActor& me, std::vector<BossAttack>& attacks)
+    {
+        using State = PatrolMachine::State;
+        const auto hit = [&me] { return (me.pendingEvents & static_cast<std::uint32_t>(BossEvent::Hit)) != 0; };
+        const auto beginSpin = [&] { --me.health; me.spinning = true; m.timer = 30; m.state = State::Spin; };
+
+        for (;;)
+        {
+            switch (m.state)
+            {
+            case State::Start:
+                if (me.health <= 0)
+                {
+                    m.state = State::Done;
+                    return;
+                }
+                me.facingRight = Target.x > me.position.x;
+                me.velocity.x = me.facingRight ? 80.f : -80.f;
+                m.timer = 60;
+                m.state = State::Walk;
+                return;
+            case State::Walk:
+                if (--m.timer)
+                    return;
+                me.velocity.x = 0.f;
+                me.velocity.y = -500.f;
+                me.onGround = false;
+                m.timer = 180;
+                m.state = State::Hop;
+                return;
+            case State::Hop:
+                if (!(me.pendingEvents & static_cast<std::uint32_t>(BossEvent::Landed)) && --m.timer)
+                    return;
+                m.shots = 0;
+                m.state = State::Shoot;
+                break;
+            case State::Shoot:
+                if (m.shots == 3)
+                {
+                    m.state = State::WaitForHit;
+                    break;
+                }
+                attacks.push_back({ BossAttack::Kind::Fireball, me.position, { me.facingRight ? 200.f : -200.f, 0.f } });
+                ++m.shots;
+                m.timer = 10;
+                m.state = State::ShootWait;
+                return;
+            case State::ShootWait:
+                if (--m.timer)
+                    return;
+                m.state = State::Shoot;
+                break;
+            case State::WaitForHit:
+                if (hit())
+                {
+                    beginSpin();
+                    return;
+                }
+                m.timer = 90;
+                m.state = State::Wait;
+                return;
+            case State::Wait:
+                if (hit())
+                {
+                    beginSpin();
+                    return;
+                }
+                if (--m.timer)
+                    return;
+                m.state = State::Start;
+                break;
+            case State::Spin:
+                if (--m.timer)
+                    return;
+                me.spinning = false;
+                m.state = State::Start;
+                break;
+            case State::Done:
+                return;
+            }
+        }
+    }
+
+    sf::Vector2f spawnPosition(std::size_t i)
+    {
+        return { ArenaLeft + static_cast<float>(i % 97) * (ArenaRight - ArenaLeft) / 97.f, GroundY };
+    }
+
+    struct RunResult
+    {
+        sf::Time time;
+        std::uint64_t attacks = 0;
+    };
+
+    RunResult runCoroutines(const BossBenchmarkConfig& config, std::size_t& poolPeak, std::size_t& heapFallbacks)
+    {
+        ScriptHost host(config.actors, GroundY, ArenaLeft, ArenaRight);
+        host.setTarget(Target);
+        for (std::size_t i = 0; i < config.actors; ++i)
+            host.spawn(BossKind::Bowser, spawnPosition(i), [](ScriptContext& c) { return patrolScript(c); });
+
+        Random hits(7);
+        RunResult result;
+        sf::Clock clock;
+        for (std::uint32_t t = 0; t < config.ticks; ++t)
+        {
+            for (std::size_t i = 0; i < config.actors; ++i)
+                if (hits.chance(HitChance))
+                    host.signal(i, BossEvent::Hit);
+            host.update();
+            result.attacks += host.attacks().size();
+        }
+        result.time = clock.getElapsedTime();
+        poolPeak = host.pool().peak();
+        heapFallbacks = host.pool().heapFallbacks();
+        return result;
+    }
+
+    RunResult runMachines(const BossBenchmarkConfig& config)
+    {
+        std::vector<BossActor> actors(config.actors);
+        std::vector<PatrolMachine> machines(config.actors);
+        std::vector<BossAttack> attacks;
+        attacks.reserve(config.actors * 4);
+        for (std::size_t i = 0; i < config.actors; ++i)
+            actors[i].position = spawnPosition(i);
+
+        Random hits(7);
+        RunResult result;
+        sf::Clock clock;
+        for (std::uint32_t t = 0; t < config.ticks; ++t)
+        {
+            for (std::size_t i = 0; i < config.actors; ++i)
+                if (hits.chance(HitChance))
+                    actors[i].pendingEvents |= static_cast<std::uint32_t>(BossEvent::Hit);
+
+            attacks.clear();
+            for (std::size_t i = 0; i < config.actors; ++i)
+            {
+                BossActor& actor = actors[i];
+                stepBossMotion(actor, GroundY, ArenaLeft, ArenaRight);
+                if (std::abs(actor.position.x - Target.x) < AlertRange)
+                    actor.pendingEvents |= static_cast<std::uint32_t>(BossEvent::PlayerClose);
+                updateMachine(machines[i], actor, attacks);
+                actor.pendingEvents = 0;
+            }
+            result.attacks += attacks.size();
+        }
+        result.time = clock.getElapsedTime();
+        return result;
+    }
+}
+
+int runBossBenchmark(const BossBenchmarkConfig& config)
+{
+    RunResult bestCoroutine{ sf::microseconds(std::numeric_limits<std::int64_t>::max()) };
+    RunResult bestMachine{ sf::microseconds(std::numeric_limits<std::int64_t>::max()) };
+    std::size_t poolPeak = 0;
+    std::size_t heapFallbacks = 0;
+
+    for (int r = 0; r < std::max(1, config.repeats); ++r)
+    {
+        const RunResult coroutine = runCoroutines(config, poolPeak, heapFallbacks);
+        if (coroutine.time < bestCoroutine.time)
+            bestCoroutine = coroutine;
+        const RunResult machine = runMachines(config);
+        if (machine.time < bestMachine.time)
+            bestMachine = machine;
+    }
+
+    const double actorTicks = static_cast<double>(config.actors) * config.ticks;
+    std::cout << std::fixed << std::setprecision(1)
+              << "Boss scripts: " << config.actors << " actors x " << config.ticks << " ticks, best of " << config.repeats << "\n"
+              << "  coroutines     " << bestCoroutine.time.asMicroseconds() * 1000.0 / actorTicks << " ns/actor/tick, "
+              << bestCoroutine.attacks << " attacks, frame pool peak " << poolPeak << " blocks, " << heapFallbacks << " heap fallbacks\n"
+              << "  state machines " << bestMachine.time.asMicroseconds() * 1000.0 / actorTicks << " ns/actor/tick, "
+              << bestMachine.attacks << " attacks" << std::endl;
+
+    if (bestCoroutine.attacks != bestMachine.attacks)
+    {
+        std::cout << "  the two versions disagree" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include "BossScript.h"
+#include "World.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <new>
+
+namespace
+{
+    constexpr float Gravity = 1600.f;       // bosses are heavier than Mario
+}
+
+FramePool::FramePool(std::size_t blockSize, std::size_t blockCount) :
+    m_blockSize((blockSize + sizeof(Header) + alignof(Header) - 1) / alignof(Header) * alignof(Header)),
+    m_storage(new unsigned char[m_blockSize * blockCount + alignof(Header)])
+{
+    // new[] of unsigned char only promises the default new alignment, so line up by hand
+    auto* base = reinterpret_cast<unsigned char*>(
+        (reinterpret_cast<std::uintptr_t>(m_storage.get()) + alignof(Header) - 1) / alignof(Header) * alignof(Header));
+
+    for (std::size_t i = blockCount; i-- > 0;)
+    {
+        auto* block = reinterpret_cast<FreeBlock*>(base + i * m_blockSize);
+        block->next = m_free;
+        m_free = block;
+    }
+}
+
+void* FramePool::allocate(std::size_t size)
+{
+    Header* header;
+    if (m_free && size + sizeof(Header) <= m_blockSize)
+    {
+        header = reinterpret_cast<Header*>(m_free);
+        m_free = m_free->next;
+        header->pool = this;
+        m_peak = std::max(m_peak, ++m_inUse);
+    }
+    else
+    {
+        header = static_cast<Header*>(::operator new(size + sizeof(Header)));
+        header->pool = nullptr;
+        ++m_heapFallbacks;
+    }
+    return header + 1;
+}
+
+void FramePool::release(void* frame)
+{
+    Header* header = static_cast<Header*>(frame) - 1;
+    FramePool* pool = header->pool;
+    if (!pool)
+    {
+        ::operator delete(header);
+        return;
+    }
+
+    auto* block = reinterpret_cast<FreeBlock*>(header);
+    block->next = pool->m_free;
+    pool->m_free = block;
+    --pool->m_inUse;
+}
+
+void stepBossMotion(BossActor& actor, float groundY, float arenaLeft, float arenaRight)
+{
+    if (!actor.onGround)
+        actor.velocity.y += Gravity * TickSeconds;
+    actor.position += actor.velocity * TickSeconds;
+    actor.position.x = std::clamp(actor.position.x, arenaLeft, arenaRight);
+    if (!actor.onGround && actor.position.y >= groundY)
+    {
+        actor.position.y = groundY;
+        actor.velocity.y = 0.f;
+        actor.onGround = true;
+        actor.pendingEvents |= static_cast<std::uint32_t>(BossEvent::Landed);
+    }
+}
+
+Script& Script::operator=(Script&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_handle)
+            m_handle.destroy();
+        m_handle = other.m_handle;
+        other.m_handle = nullptr;
+    }
+    return *this;
+}
+
+Script::~Script()
+{
+    if (m_handle)
+        m_handle.destroy();
+}
+
+BossActor& ScriptContext::self()
+{
+    return host->m_actors[actor];
+}
+
+sf::Vector2f ScriptContext::target() const
+{
+    return host->m_target;
+}
+
+void ScriptContext::attack(BossAttack::Kind kind, sf::Vector2f velocity, sf::Vector2f offset)
+{
+    const BossActor& me = self();
+    if (!me.facingRight)
+    {
+        velocity.x = -velocity.x;
+        offset.x = -offset.x;
+    }
+    host->m_attacks.push_back({ kind, me.position + offset, velocity });
+}
+
+ScriptContext::TickAwaiter ScriptContext::seconds(float duration)
+{
+    return { *this, static_cast<std::uint32_t>(std::lround(duration * TickRate)) };
+}
+
+void ScriptContext::TickAwaiter::await_suspend(std::coroutine_handle<> h) noexcept
+{
+    context.current = h;
+    context.resumeTick = context.host->tick() + ticks;
+    context.eventMask = 0;
+}
+
+bool ScriptContext::EventAwaiter::await_ready() noexcept
+{
+    // the event may already have arrived this tick, before the script got here
+    const std::uint32_t pending = context.self().pendingEvents & mask;
+    context.wokenBy = pending;
+    return pending != 0;
+}
+
+void ScriptContext::EventAwaiter::await_suspend(std::coroutine_handle<> h) noexcept
+{
+    context.current = h;
+    context.eventMask = mask;
+    context.resumeTick = timeoutTicks ? context.host->tick() + timeoutTicks : ScriptHost::Forever;
+}
+
+std::optional<BossEvent> ScriptContext::EventAwaiter::await_resume() const noexcept
+{
+    if (!context.wokenBy)
+        return std::nullopt;
+    // lowest bit wins if several arrived in the same tick
+    return static_cast<BossEvent>(context.wokenBy & (~context.wokenBy + 1));
+}
+
+ScriptHost::ScriptHost(std::size_t capacity, float groundY, float arenaLeft, float arenaRight) :
+    m_capacity(capacity),
+    m_groundY(groundY),
+    m_arenaLeft(arenaLeft),
+    m_arenaRight(arenaRight),
+    m_pool(FrameBlockSize, capacity * 2)    // room for each actor's script plus one nested move
+{
+    m_actors.reserve(capacity);
+    m_contexts.reserve(capacity);
+    m_scripts.reserve(capacity);
+    m_attacks.reserve(capacity * 4);
+}
+
+void ScriptHost::signal(std::size_t actor, BossEvent event)
+{
+    m_actors[actor].pendingEvents |= static_cast<std::uint32_t>(event);
+}
+
+void ScriptHost::update()
+{
+    ++m_tick;
+    m_attacks.clear();
+
+    for (std::size_t i = 0; i < m_actors.size(); ++i)
+    {
+        BossActor& actor = m_actors[i];
+        ScriptContext& context = m_contexts[i];
+
+        stepBossMotion(actor, m_groundY, m_arenaLeft, m_arenaRight);
+        if (std::abs(actor.position.x - m_target.x) < m_alertRange)
+            actor.pendingEvents |= static_cast<std::uint32_t>(BossEvent::PlayerClose);
+
+        // Decided from the context alone; the coroutine frame is only touched
+        // when the script actually runs.
+        const std::uint32_t woken = actor.pendingEvents & context.eventMask;
+        if (woken || context.resumeTick <= m_tick)
+        {
+            context.wokenBy = woken;
+            context.eventMask = 0;
+            context.current.resume();
+            if (m_scripts[i].done())
+                context.resumeTick = Forever;
+        }
+
+        // events are edges: whatever nobody was waiting for this tick is dropped
+        actor.pendingEvents = 0;
+    }
+}
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <vector>
+
+class ScriptHost;
+struct ScriptContext;
+
+// Fixed-size blocks for coroutine frames. Spawning a scripted actor must not
+// hit the heap every time, and a frame is freed on whatever thread steps its
+// host, so the pool belongs to the host rather than the thread. Each block
+// starts with a header naming its pool, so release() needs only the pointer.
+// Frames too big for a block, or requested when the pool is empty, come from
+// the heap and are counted so the block size can be tuned.
+class FramePool
+{
+public:
+    FramePool(std::size_t blockSize, std::size_t blockCount);
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    void* allocate(std::size_t size);
+    static void release(void* frame);
+
+    std::size_t inUse() const { return m_inUse; }
+    std::size_t peak() const { return m_peak; }
+    std::size_t heapFallbacks() const { return m_heapFallbacks; }
+
+private:
+    struct alignas(16) Header
+    {
+        FramePool* pool;        // null for frames that came from the heap
+    };
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    std::size_t m_blockSize;
+    std::unique_ptr<unsigned char[]> m_storage;
+    FreeBlock* m_free = nullptr;
+    std::size_t m_inUse = 0;
+    std::size_t m_peak = 0;
+    std::size_t m_heapFallbacks = 0;
+};
+
+// Things a script can wait for besides time. Bits, so one wait can take several.
+enum class BossEvent : std::uint32_t
+{
+    Landed = 1u << 0,       // touched the ground after being airborne
+    Hit = 1u << 1,          // stomped or struck by the player
+    PlayerClose = 1u << 2,  // player came within the host's alert range
+};
+
+constexpr std::uint32_t operator|(BossEvent a, BossEvent b)
+{
+    return static_cast<std::uint32_t>(a) | static_cast<std::uint32_t>(b);
+}
+
+// A boss behaviour written as a coroutine. Every script function takes a
+// ScriptContext& as its first parameter. The promise uses it to allocate the
+// frame from the host's pool, and a script can't be declared without it.
+// Scripts can co_await other scripts to reuse moves such as "hop".
+class [[nodiscard]] Script
+{
+public:
+    struct promise_type
+    {
+        std::coroutine_handle<> continuation;
+
+        Script get_return_object() { return Script(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept
+        {
+            struct FinalAwaiter
+            {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept
+                {
+                    // hand control back to the script that awaited this one, if any
+                    if (h.promise().continuation)
+                        return h.promise().continuation;
+                    return std::noop_coroutine();
+                }
+                void await_resume() noexcept {}
+            };
+            return FinalAwaiter{};
+        }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        template <typename... Args>
+        static void* operator new(std::size_t size, ScriptContext& context, Args&...);
+        static void operator delete(void* frame) { FramePool::release(frame); }
+    };
+
+    Script(Script&& other) noexcept : m_handle(other.m_handle) { other.m_handle = nullptr; }
+    Script& operator=(Script&& other) noexcept;
+    ~Script();
+
+    bool done() const { return !m_handle || m_handle.done(); }
+    std::coroutine_handle<promise_type> handle() const { return m_handle; }
+
+    // co_await on a sub-script runs it to completion before carrying on.
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        m_handle.promise().continuation = awaiting;
+        return m_handle;
+    }
+    void await_resume() const noexcept {}
+
+private:
+    explicit Script(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+enum class BossKind : std::uint8_t
+{
+    Bowser,
+    Ludwig,
+    Roy,
+    Wendy,
+    Larry,
+    Iggy,
+    Lemmy,
+    Morton,
+    BoomBoom,
+    Count
+};
+
+struct BossActor
+{
+    BossKind kind = BossKind::Bowser;
+    sf::Vector2f position;
+    sf::Vector2f velocity;
+    int health = 3;
+    bool onGround = true;
+    bool facingRight = false;
+    bool spinning = false;          // shell dash / Boom Boom spin: can't be stomped
+    std::uint32_t pendingEvents = 0;
+};
+
+// What a boss throws. The host only collects these; whoever owns projectiles spawns them.
+struct BossAttack
+{
+    enum class Kind : std::uint8_t { Fireball, WandBlast, Shockwave };
+
+    Kind kind;
+    sf::Vector2f position;
+    sf::Vector2f velocity;
+};
+
+// Gravity, arena walls and landing. Sets BossEvent::Landed in pendingEvents on touchdown.
+void stepBossMotion(BossActor& actor, float groundY, float arenaLeft, float arenaRight);
+
+// Per-actor script state, the part of an actor that scripts talk to.
+struct ScriptContext
+{
+    ScriptHost* host = nullptr;
+    std::size_t actor = 0;
+    std::coroutine_handle<> current;                // innermost suspended script
+    std::uint32_t resumeTick = 0;
+    std::uint32_t eventMask = 0;
+    std::uint32_t wokenBy = 0;                      // events that ended the last wait
+
+    BossActor& self();
+    sf::Vector2f target() const;
+    void attack(BossAttack::Kind kind, sf::Vector2f velocity, sf::Vector2f offset = {});
+
+    struct TickAwaiter
+    {
+        ScriptContext& context;
+        std::uint32_t ticks;
+
+        bool await_ready() const noexcept { return ticks == 0; }
+        void await_suspend(std::coroutine_handle<> h) noexcept;
+        void await_resume() const noexcept {}
+    };
+
+    struct EventAwaiter
+    {
+        ScriptContext& context;
+        std::uint32_t mask;
+        std::uint32_t timeoutTicks;                 // 0: no timeout
+
+        bool await_ready() noexcept;
+        void await_suspend(std::coroutine_handle<> h) noexcept;
+        // The event that arrived, or nothing if the wait timed out.
+        std::optional<BossEvent> await_resume() const noexcept;
+    };
+
+    TickAwaiter ticks(std::uint32_t count) { return { *this, count }; }
+    TickAwaiter seconds(float duration);
+    EventAwaiter event(std::uint32_t mask, std::uint32_t timeoutTicks = 0) { return { *this, mask, timeoutTicks }; }
+    EventAwaiter event(BossEvent which, std::uint32_t timeoutTicks = 0) { return { *this, static_cast<std::uint32_t>(which), timeoutTicks }; }
+};
+
+// Runs scripted actors once per simulation tick. An actor only costs a
+// couple of compares per tick while its script waits. The script itself
+// runs only on the tick it asked to wake up on, or when an event it waits
+// for arrives.
+class ScriptHost
+{
+public:
+    static constexpr std::size_t FrameBlockSize = 512;
+    static constexpr std::uint32_t Forever = 0xFFFFFFFFu;
+
+    ScriptHost(std::size_t capacity, float groundY, float arenaLeft, float arenaRight);
+
+    // The script factory is called with the new actor's context, e.g.
+    // host.spawn(kind, pos, [](ScriptContext& c) { return bowserScript(c); }).
+    // Returns the actor index, or nothing if the host is full.
+    template <typename Factory>
+    std::optional<std::size_t> spawn(BossKind kind, sf::Vector2f position, Factory&& factory);
+
+    void setTarget(sf::Vector2f target) { m_target = target; }
+    sf::Vector2f target() const { return m_target; }
+
+    // Delivered on the next update().
+    void signal(std::size_t actor, BossEvent event);
+
+    void update();
+
+    std::uint32_t tick() const { return m_tick; }
+    std::size_t size() const { return m_actors.size(); }
+    BossActor& actor(std::size_t index) { return m_actors[index]; }
+    const BossActor& actor(std::size_t index) const { return m_actors[index]; }
+    bool finished(std::size_t index) const { return m_scripts[index].done(); }
+
+    // Attacks made during the last update().
+    const std::vector<BossAttack>& attacks() const { return m_attacks; }
+
+    FramePool& pool() { return m_pool; }
+    const FramePool& pool() const { return m_pool; }
+
+private:
+    friend struct ScriptContext;
+
+    std::size_t m_capacity;
+    float m_groundY;
+    float m_arenaLeft;
+    float m_arenaRight;
+    float m_alertRange = 160.f;
+    sf::Vector2f m_target;
+    std::uint32_t m_tick = 0;
+    FramePool m_pool;
+    std::vector<BossActor> m_actors;
+    std::vector<ScriptContext> m_contexts;      // reserved up front: frames hold references into it
+    std::vector<Script> m_scripts;
+    std::vector<BossAttack> m_attacks;
+};
+
+template <typename... Args>
+void* Script::promise_type::operator new(std::size_t size, ScriptContext& context, Args&...)
+{
+    return context.host->pool().allocate(size);
+}
+
+template <typename Factory>
+std::optional<std::size_t> ScriptHost::spawn(BossKind kind, sf::Vector2f position, Factory&& factory)
+{
+    if (m_actors.size() == m_capacity)
+        return std::nullopt;
+
+    const std::size_t index = m_actors.size();
+    BossActor& actor = m_actors.emplace_back();
+    actor.kind = kind;
+    actor.position = position;
+
+    ScriptContext& context = m_contexts.emplace_back();
+    context.host = this;
+    context.actor = index;
+
+    m_scripts.push_back(factory(context));
+    context.current = m_scripts.back().handle();
+    context.resumeTick = m_tick + 1;
+    return index;
+}
@@ -0,0 +1,156 @@
+#include "Bosses.h"
+#include "World.h"
+
+#include <array>
+
+namespace
+{
+    // Ludwig through Morton, in BossKind order. Ludwig hops high and fires
+    // the most, Morton is slow but heavy-handed, Lemmy barely shoots.
+    const std::array<KoopalingStyle, 7> KoopalingStyles{ {
+        //  hop    walk  hops shots  shot   dash   rest
+        { 640.f,  90.f,  3,   3,   260.f, 320.f, 60 },     // Ludwig
+        { 520.f,  70.f,  2,   2,   220.f, 280.f, 75 },     // Roy
+        { 560.f, 110.f,  3,   2,   240.f, 300.f, 70 },     // Wendy
+        { 500.f, 120.f,  2,   1,   200.f, 260.f, 80 },     // Larry
+        { 600.f, 130.f,  4,   1,   220.f, 300.f, 70 },     // Iggy
+        { 480.f,  80.f,  2,   1,   180.f, 240.f, 90 },     // Lemmy
+        { 460.f,  60.f,  2,   3,   200.f, 260.f, 85 },     // Morton
+    } };
+
+    void faceTarget(ScriptContext& context)
+    {
+        BossActor& me = context.self();
+        me.facingRight = context.target().x > me.position.x;
+    }
+
+    Script hop(ScriptContext& context, float up, float forward)
+    {
+        BossActor& me = context.self();
+        faceTarget(context);
+        me.velocity = { me.facingRight ? forward : -forward, -up };
+        me.onGround = false;
+        co_await context.event(BossEvent::Landed, 3 * TickRate);
+        me.velocity.x = 0.f;
+    }
+
+    Script shellDash(ScriptContext& context, float speed, std::uint32_t ticks)
+    {
+        BossActor& me = context.self();
+        faceTarget(context);
+        me.spinning = true;
+        me.velocity.x = me.facingRight ? speed : -speed;
+        co_await context.ticks(ticks);
+        me.velocity.x = 0.f;
+        me.spinning = false;
+    }
+}
+
+const KoopalingStyle& koopalingStyle(BossKind kind)
+{
+    return KoopalingStyles[static_cast<std::size_t>(kind) - static_cast<std::size_t>(BossKind::Ludwig)];
+}
+
+Script bowserScript(ScriptContext& context)
+{
+    BossActor& me = context.self();
+    me.health = 5;
+
+    while (me.health > 0)
+    {
+        // stalk the player until they come close, or give up after a while
+        faceTarget(context);
+        me.velocity.x = me.facingRight ? 60.f : -60.f;
+        const auto woke = co_await context.event(BossEvent::PlayerClose | BossEvent::Hit, 90);
+        me.velocity.x = 0.f;
+        if (woke == BossEvent::Hit)
+        {
+            --me.health;
+            co_await context.seconds(0.5f);
+            continue;
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+            faceTarget(context);
+            context.attack(BossAttack::Kind::Fireball, { 240.f, 0.f }, { 40.f, 12.f });
+            co_await context.seconds(0.4f);
+        }
+
+        // ground pound: shockwaves roll out both ways
+        co_await hop(context, 720.f, 0.f);
+        context.attack(BossAttack::Kind::Shockwave, { 200.f, 0.f });
+        context.attack(BossAttack::Kind::Shockwave, { -200.f, 0.f });
+
+        if (co_await context.event(BossEvent::Hit, TickRate))
+            --me.health;
+    }
+}
+
+Script koopalingScript(ScriptContext& context, const KoopalingStyle& style)
+{
+    BossActor& me = context.self();
+    me.health = 3;
+
+    while (me.health > 0)
+    {
+        for (int i = 0; i < style.hopsPerRound; ++i)
+            co_await hop(context, style.hopSpeed, style.walkSpeed);
+
+        for (int i = 0; i < style.shotsPerVolley; ++i)
+        {
+            faceTarget(context);
+            context.attack(BossAttack::Kind::WandBlast, { style.shotSpeed, 0.f }, { 16.f, -8.f });
+            co_await context.ticks(12);
+        }
+
+        if (co_await context.event(BossEvent::Hit, style.restTicks))
+        {
+            --me.health;
+            if (me.health > 0)
+                co_await shellDash(context, style.dashSpeed, TickRate * 3 / 2);
+        }
+    }
+}
+
+Script boomBoomScript(ScriptContext& context)
+{
+    BossActor& me = context.self();
+    me.health = 3;
+
+    while (me.health > 0)
+    {
+        // charges faster with every hit taken
+        const float speed = 120.f + 60.f * static_cast<float>(3 - me.health);
+        for (int i = 0; i < 2; ++i)
+        {
+            faceTarget(context);
+            me.velocity.x = me.facingRight ? speed : -speed;
+            co_await context.seconds(1.2f);
+        }
+        me.velocity.x = 0.f;
+
+        co_await hop(context, 600.f, 150.f);
+
+        if (co_await context.event(BossEvent::Hit, 45))
+        {
+            --me.health;
+            me.spinning = true;
+            co_await context.seconds(1.f);
+            me.spinning = false;
+        }
+    }
+}
+
+std::optional<std::size_t> spawnBoss(ScriptHost& host, BossKind kind, sf::Vector2f position)
+{
+    switch (kind)
+    {
+    case BossKind::Bowser:
+        return host.spawn(kind, position, [](ScriptContext& c) { return bowserScript(c); });
+    case BossKind::BoomBoom:
+        return host.spawn(kind, position, [](ScriptContext& c) { return boomBoomScript(c); });
+    default:
+        return host.spawn(kind, position, [kind](ScriptContext& c) { return koopalingScript(c, koopalingStyle(kind)); });
+    }
+}
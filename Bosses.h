@@ -0,0 +1,27 @@
+#pragma once
+
+#include "BossScript.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+
+// Tuning that sets the Koopalings apart; they all share one script.
+struct KoopalingStyle
+{
+    float hopSpeed;             // vertical take-off speed
+    float walkSpeed;
+    int hopsPerRound;
+    int shotsPerVolley;
+    float shotSpeed;
+    float dashSpeed;            // shell dash after being stomped
+    std::uint32_t restTicks;    // pause between rounds, the player's opening
+};
+
+const KoopalingStyle& koopalingStyle(BossKind kind);
+
+Script bowserScript(ScriptContext& context);
+Script koopalingScript(ScriptContext& context, const KoopalingStyle& style);
+Script boomBoomScript(ScriptContext& context);
+
+// Spawns kind's script at position; nothing if the host is full.
+std::optional<std::size_t> spawnBoss(ScriptHost& host, BossKind kind, sf::Vector2f position);
@@ -0,0 +1,123 @@
+#include "BotClient.h"
+#include "NetProtocol.h"
+
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+#include <iostream>
+
+std::uint16_t botInput(std::size_t index, std::uint32_t tick)
+{
+    const std::uint32_t period = 30 + static_cast<std::uint32_t>(index % 7) * 5;
+    std::uint16_t mask = InputFrame::bit(Action::Right);
+    if ((tick + index) % period < 10)
+        mask |= InputFrame::bit(Action::Jump);
+    if (index % 2 == 0)
+        mask |= InputFrame::bit(Action::Run);
+    return mask;
+}
+
+BotSwarm::BotSwarm(sf::IpAddress server, unsigned short port, std::size_t count) :
+    m_server(server),
+    m_port(port),
+    m_bots(count)
+{
+    for (Bot& bot : m_bots)
+    {
+        if (bot.socket.bind(sf::Socket::AnyPort) != sf::Socket::Status::Done)
+            std::cerr << "Error: Failed to bind bot socket" << std::endl;
+        bot.socket.setBlocking(false);
+    }
+}
+
+void BotSwarm::run(const std::atomic<bool>& running)
+{
+    const sf::Time tickTime = sf::seconds(TickSeconds);
+    sf::Clock clock;
+    sf::Clock reportClock;
+    sf::Time nextTick = clock.getElapsedTime();
+
+    while (running)
+    {
+        for (std::size_t i = 0; i < m_bots.size(); ++i)
+        {
+            receive(m_bots[i]);
+            send(m_bots[i], i);
+        }
+        ++m_tick;
+
+        if (reportClock.getElapsedTime() >= sf::seconds(5.f))
+        {
+            const auto joined = std::count_if(m_bots.begin(), m_bots.end(), [](const Bot& b) { return b.world.has_value(); });
+            const auto alive = std::count_if(m_bots.begin(), m_bots.end(), [](const Bot& b) { return b.world && b.alive; });
+            std::uint64_t states = 0;
+            for (Bot& bot : m_bots)
+            {
+                states += bot.statesReceived;
+                bot.statesReceived = 0;
+            }
+            std::cout << "bots: " << joined << "/" << m_bots.size() << " joined, " << alive << " alive, "
+                      << states / std::max<std::size_t>(1, m_bots.size()) / 5 << " states/s per bot" << std::endl;
+            reportClock.restart();
+        }
+
+        nextTick += tickTime;
+        const sf::Time now = clock.getElapsedTime();
+        if (nextTick > now)
+            sf::sleep(nextTick - now);
+        else
+            nextTick = now;
+    }
+
+    sf::Packet leave;
+    leave << net::MessageType::Leave;
+    for (Bot& bot : m_bots)
+        if (bot.world)
+            (void)bot.socket.send(leave, m_server, m_port);
+}
+
+void BotSwarm::send(Bot& bot, std::size_t index)
+{
+    sf::Packet packet;
+    if (!bot.world)
+    {
+        // keep knocking twice a second until the server lets us in
+        if (m_tick % 30 != index % 30)
+            return;
+        packet << net::MessageType::Join;
+    }
+    else
+        packet << net::MessageType::Input << m_tick << botInput(index, m_tick);
+    (void)bot.socket.send(packet, m_server, m_port);
+}
+
+void BotSwarm::receive(Bot& bot)
+{
+    sf::Packet packet;
+    std::optional<sf::IpAddress> address;
+    unsigned short port = 0;
+
+    while (bot.socket.receive(packet, address, port) == sf::Socket::Status::Done)
+    {
+        net::MessageType type{};
+        if (!(packet >> type))
+            continue;
+
+        if (type == net::MessageType::Welcome)
+        {
+            std::uint16_t world = 0;
+            if (packet >> world)
+                bot.world = world;
+        }
+        else if (type == net::MessageType::State)
+        {
+            net::PlayerSnapshot snapshot;
+            if (packet >> snapshot)
+            {
+                bot.alive = snapshot.alive;
+                ++bot.statesReceived;
+            }
+        }
+    }
+}
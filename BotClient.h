@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// What bot index holds on tick: right, jumping on its own rhythm so the bots
+// don't all stomp in lockstep, and every other bot running.
+std::uint16_t botInput(std::size_t index, std::uint32_t tick);
+
+// A crowd of scripted battle clients for load-testing the server. Each bot
+// has its own UDP socket, joins, then sends input every tick like a real
+// client. They run right and jump on a per-bot rhythm, so they stomp
+// enemies and sometimes walk into one.
+class BotSwarm
+{
+public:
+    BotSwarm(sf::IpAddress server, unsigned short port, std::size_t count);
+
+    void run(const std::atomic<bool>& running);
+
+private:
+    struct Bot
+    {
+        sf::UdpSocket socket;
+        std::optional<std::uint16_t> world;
+        std::uint32_t statesReceived = 0;
+        bool alive = true;
+    };
+
+    void send(Bot& bot, std::size_t index);
+    void receive(Bot& bot);
+
+    sf::IpAddress m_server;
+    unsigned short m_port;
+    std::vector<Bot> m_bots;
+    std::uint32_t m_tick = 0;
+};
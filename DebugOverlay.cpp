@@ -0,0 +1,32 @@
+#include "DebugOverlay.h"
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/View.hpp>
+
+void DebugOverlay::setFont(const sf::Font& font)
+{
+    m_text.emplace(font, "", 14);
+    m_text->setFillColor(sf::Color::White);
+    m_text->setPosition({ 8.f, 6.f });
+}
+
+void DebugOverlay::draw(sf::RenderTarget& target, const std::string& text)
+{
+    if (!m_visible || !m_text)
+        return;
+
+    m_text->setString(text);
+
+    const sf::View previousView = target.getView();
+    target.setView(target.getDefaultView());
+
+    // dark backing so the numbers stay readable over the bright background
+    const sf::FloatRect bounds = m_text->getGlobalBounds();
+    sf::RectangleShape backing(bounds.size + sf::Vector2f(12.f, 12.f));
+    backing.setPosition(bounds.position - sf::Vector2f(6.f, 6.f));
+    backing.setFillColor(sf::Color(0, 0, 0, 160));
+
+    target.draw(backing);
+    target.draw(*m_text);
+    target.setView(previousView);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <optional>
+#include <string>
+
+// Text overlay for profiler numbers and other debug stats, toggled with F3.
+// Drawn in window pixels, on top of whatever view the game uses.
+class DebugOverlay
+{
+public:
+    void setFont(const sf::Font& font);
+
+    void toggle() { m_visible = !m_visible; }
+    bool isVisible() const { return m_visible; }
+
+    // Only build the text when isVisible(), it is thrown away otherwise.
+    void draw(sf::RenderTarget& target, const std::string& text);
+
+private:
+    std::optional<sf::Text> m_text;
+    bool m_visible = false;
+};
@@ -0,0 +1,193 @@
+#include "DesyncDetector.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <string>
+
+namespace
+{
+    template <typename T>
+    void diffField(std::ostream& out, const std::string& name, const T& local, const T& remote)
+    {
+        if (local == remote)
+            return;
+        out << "  " << std::left << std::setw(24) << name << std::right
+            << " local " << std::setw(14) << +local << "  remote " << std::setw(14) << +remote << "\n";
+    }
+
+    void diffVector(std::ostream& out, const std::string& name, sf::Vector2f local, sf::Vector2f remote)
+    {
+        diffField(out, name + ".x", local.x, remote.x);
+        diffField(out, name + ".y", local.y, remote.y);
+    }
+
+    void hashLine(std::ostream& out, const char* name, std::uint64_t local, std::uint64_t remote)
+    {
+        out << "  " << std::left << std::setw(8) << name << std::right << std::hex << std::setfill('0')
+            << std::setw(16) << local << " vs " << std::setw(16) << remote
+            << std::dec << std::setfill(' ') << (local == remote ? "" : "  <-- differs") << "\n";
+    }
+}
+
+void DesyncDetector::Snapshot::capture(const World& world)
+{
+    tick = world.tick();
+    playerCount = world.playerCount();
+    for (std::size_t i = 0; i < playerCount; ++i)
+        players[i] = world.player(i);
+
+    for (std::size_t a = 0; a < EnemyArchetypeCount; ++a)
+    {
+        const EnemyStore::Batch& batch = world.enemies().batch(static_cast<EnemyArchetype>(a));
+        Enemies& columns = enemies[a];
+        columns.x = batch.x;
+        columns.y = batch.y;
+        columns.vx = batch.vx;
+        columns.vy = batch.vy;
+        columns.phase = batch.phase;
+        columns.timer = batch.timer;
+        columns.type = batch.type;
+    }
+
+    const ProjectilePool& pool = world.projectiles();
+    projectiles.clear();
+    for (std::size_t i = 0; i < pool.size(); ++i)
+        projectiles.push_back(pool.state(i));
+
+    checkpointReached = world.checkpointReached();
+    levelComplete = world.levelComplete();
+    timeLeft = world.timeLeft();
+    timerCount = world.timers().size();
+    for (std::size_t i = 0; i < RandomStreamCount; ++i)
+        random[i] = world.random(static_cast<RandomStream>(i)).state();
+}
+
+void DesyncDetector::record(const World& world)
+{
+    const StateHashes hashes = world.hashState();
+    if (m_history.size() < HistoryTicks)
+    {
+        m_history.emplace_back();
+        m_history.back().hashes = hashes;
+        m_history.back().snapshot.capture(world);
+        return;
+    }
+
+    // capturing over an old entry reuses its storage
+    Entry& entry = m_history[m_next];
+    entry.hashes = hashes;
+    entry.snapshot.capture(world);
+    m_next = (m_next + 1) % HistoryTicks;
+}
+
+std::optional<StateHashes> DesyncDetector::local(std::uint32_t tick) const
+{
+    if (const Entry* entry = find(tick))
+        return entry->hashes;
+    return std::nullopt;
+}
+
+const DesyncDetector::Snapshot* DesyncDetector::snapshot(std::uint32_t tick) const
+{
+    if (const Entry* entry = find(tick))
+        return &entry->snapshot;
+    return nullptr;
+}
+
+bool DesyncDetector::compare(const StateHashes& remote, std::ostream& log)
+{
+    const Entry* entry = find(remote.tick);
+    if (!entry || entry->hashes == remote)
+        return true;
+
+    if (!m_desyncTick)
+    {
+        m_desyncTick = remote.tick;
+        log << "Desync at tick " << remote.tick << ":\n";
+        hashLine(log, "players", entry->hashes.players, remote.players);
+        hashLine(log, "enemies", entry->hashes.enemies, remote.enemies);
+        hashLine(log, "projectiles", entry->hashes.projectiles, remote.projectiles);
+        hashLine(log, "timers", entry->hashes.timers, remote.timers);
+        hashLine(log, "random", entry->hashes.random, remote.random);
+        log.flush();
+    }
+    return false;
+}
+
+void DesyncDetector::dump(const Snapshot& remote, std::ostream& out) const
+{
+    const Entry* entry = find(remote.tick);
+    if (!entry)
+    {
+        out << "Tick " << remote.tick << " is no longer in the desync history" << std::endl;
+        return;
+    }
+    const Snapshot& local = entry->snapshot;
+
+    out << "State diff at tick " << remote.tick << " (local vs remote):\n" << std::setprecision(9);
+    diffField(out, "playerCount", local.playerCount, remote.playerCount);
+    for (std::size_t i = 0; i < std::min(local.playerCount, remote.playerCount); ++i)
+    {
+        const PlayerState& a = local.players[i];
+        const PlayerState& b = remote.players[i];
+        const std::string name = "player[" + std::to_string(i) + "]";
+        diffVector(out, name + ".position", a.position, b.position);
+        diffVector(out, name + ".velocity", a.velocity, b.velocity);
+        diffField(out, name + ".onGround", a.onGround, b.onGround);
+        diffField(out, name + ".facingRight", a.facingRight, b.facingRight);
+        diffField(out, name + ".alive", a.alive, b.alive);
+        diffField(out, name + ".starPower", a.starPower, b.starPower);
+        diffField(out, name + ".invincible", a.invincible, b.invincible);
+        diffField(out, name + ".platform", a.platform, b.platform);
+    }
+
+    for (std::size_t a = 0; a < EnemyArchetypeCount; ++a)
+    {
+        const Snapshot::Enemies& mine = local.enemies[a];
+        const Snapshot::Enemies& theirs = remote.enemies[a];
+        const std::string batchName = "enemies[" + std::to_string(a) + "]";
+        diffField(out, batchName + ".size", mine.x.size(), theirs.x.size());
+        for (std::size_t i = 0; i < std::min(mine.x.size(), theirs.x.size()); ++i)
+        {
+            const std::string name = batchName + "[" + std::to_string(i) + "]";
+            diffVector(out, name + ".position", { mine.x[i], mine.y[i] }, { theirs.x[i], theirs.y[i] });
+            diffVector(out, name + ".velocity", { mine.vx[i], mine.vy[i] }, { theirs.vx[i], theirs.vy[i] });
+            diffField(out, name + ".phase", mine.phase[i], theirs.phase[i]);
+            diffField(out, name + ".timer", mine.timer[i], theirs.timer[i]);
+            diffField(out, name + ".type", mine.type[i], theirs.type[i]);
+        }
+    }
+
+    diffField(out, "projectiles.size", local.projectiles.size(), remote.projectiles.size());
+    for (std::size_t i = 0; i < std::min(local.projectiles.size(), remote.projectiles.size()); ++i)
+    {
+        const ProjectileState& a = local.projectiles[i];
+        const ProjectileState& b = remote.projectiles[i];
+        const std::string name = "projectiles[" + std::to_string(i) + "]";
+        diffVector(out, name + ".position", a.position, b.position);
+        diffVector(out, name + ".velocity", a.velocity, b.velocity);
+        diffField(out, name + ".kind", static_cast<int>(a.kind), static_cast<int>(b.kind));
+    }
+
+    diffField(out, "checkpointReached", local.checkpointReached, remote.checkpointReached);
+    diffField(out, "levelComplete", local.levelComplete, remote.levelComplete);
+    diffField(out, "timeLeft", local.timeLeft, remote.timeLeft);
+    diffField(out, "timers.size", local.timerCount, remote.timerCount);
+
+    for (std::size_t i = 0; i < RandomStreamCount; ++i)
+    {
+        const Random::State& a = local.random[i];
+        const Random::State& b = remote.random[i];
+        for (std::size_t word = 0; word < a.size(); ++word)
+            diffField(out, std::string("random.") + RandomStreamNames[i] + "[" + std::to_string(word) + "]", a[word], b[word]);
+    }
+    out << std::flush;
+}
+
+const DesyncDetector::Entry* DesyncDetector::find(std::uint32_t tick) const
+{
+    for (const Entry& entry : m_history)
+        if (entry.hashes.tick == tick)
+            return &entry;
+    return nullptr;
+}
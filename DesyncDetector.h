@@ -0,0 +1,84 @@
+#pragma once
+
+#include "StateHash.h"
+#include "World.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+// Checks one simulation against another copy that is meant to be identical:
+// a netplay peer, or a recorded replay.
+//
+// record() runs after every local step. It keeps the hashes for the last
+// HistoryTicks ticks, and a Snapshot of just the fields dump() compares;
+// the world's tiles, platforms, triggers and scratch buffers aren't copied.
+// compare() takes the other side's hashes for a tick, which might arrive a
+// few ticks late over the network. The first mismatch latches the detector
+// and logs which subsystems differ. Once the other side's snapshot for that
+// tick is at hand, dump() prints a field-by-field diff against the local one.
+class DesyncDetector
+{
+public:
+    static constexpr std::size_t HistoryTicks = 64;
+
+    // The state dump() diffs, column for column as the world keeps it.
+    struct Snapshot
+    {
+        struct Enemies
+        {
+            std::vector<float> x, y, vx, vy, phase;
+            std::vector<std::int32_t> timer;
+            std::vector<std::uint8_t> type;
+        };
+
+        std::uint32_t tick = 0;
+        std::size_t playerCount = 0;
+        std::array<PlayerState, MaxPlayers> players{};
+        std::array<Enemies, EnemyArchetypeCount> enemies;
+        std::vector<ProjectileState> projectiles;
+        bool checkpointReached = false;
+        bool levelComplete = false;
+        std::uint16_t timeLeft = 0;
+        std::size_t timerCount = 0;
+        std::array<Random::State, RandomStreamCount> random{};
+
+        // Overwrites this with world's state, reusing the vectors' storage.
+        void capture(const World& world);
+    };
+
+    void record(const World& world);
+
+    // The local hashes for a tick still in the history.
+    std::optional<StateHashes> local(std::uint32_t tick) const;
+
+    // The local state as it was after a tick, e.g. to answer a peer that
+    // saw a mismatch and wants a diff. Null once the tick has aged out.
+    const Snapshot* snapshot(std::uint32_t tick) const;
+
+    // False on mismatch. Hashes for ticks that are too old, or not yet
+    // simulated here, are skipped and return true.
+    bool compare(const StateHashes& remote, std::ostream& log);
+
+    // Tick of the first mismatch found, if any.
+    std::optional<std::uint32_t> desyncTick() const { return m_desyncTick; }
+
+    // Field-by-field differences between the local state at remote.tick and remote.
+    void dump(const Snapshot& remote, std::ostream& out) const;
+
+private:
+    struct Entry
+    {
+        StateHashes hashes;
+        Snapshot snapshot;
+    };
+
+    const Entry* find(std::uint32_t tick) const;
+
+    std::vector<Entry> m_history;       // ring buffer of the newest ticks
+    std::size_t m_next = 0;
+    std::optional<std::uint32_t> m_desyncTick;
+};
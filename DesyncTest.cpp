@@ -0,0 +1,101 @@
+#include "DesyncTest.h"
+#include "DesyncDetector.h"
+#include "NetProtocol.h"
+#include "World.h"
+
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <array>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+    struct Peer
+    {
+        World world{ { 10.f, 371.f }, 3376.f };
+        DesyncDetector detector;
+    };
+
+    // A player who keeps running into the enemies, so both players and
+    // enemies change every tick.
+    std::uint16_t scriptedInput(std::uint32_t tick)
+    {
+        std::uint16_t mask = InputFrame::bit((tick / 400) % 2 == 0 ? Action::Right : Action::Left);
+        if (tick % 40 < 8)
+            mask |= InputFrame::bit(Action::Jump);
+        return mask;
+    }
+}
+
+int runDesyncTest(const DesyncConfig& config)
+{
+    std::array<Peer, 2> peers;
+    for (Peer& peer : peers)
+        for (float x : { 600.f, 1200.f, 1800.f, 2400.f, 3000.f })
+            peer.world.spawnEnemy(x, 0);
+
+    // hashes from peer 1 on their way to peer 0
+    std::deque<std::pair<std::uint32_t, sf::Packet>> inFlight;
+
+    const auto ticks = static_cast<std::uint32_t>(config.seconds * TickRate);
+    std::uint16_t previousMask = 0;
+
+    for (std::uint32_t t = 0; t < ticks; ++t)
+    {
+        const std::uint16_t mask = scriptedInput(t);
+        std::array<InputFrame, MaxPlayers> inputs{};
+        inputs[0] = InputFrame::fromMasks(mask, previousMask);
+        previousMask = mask;
+
+        for (Peer& peer : peers)
+            peer.world.step(inputs);
+
+        // a spawn event that only reached one side
+        if (config.desyncAt != 0 && peers[1].world.tick() == config.desyncAt)
+            peers[1].world.spawnEnemy(900.f, 1);
+
+        for (Peer& peer : peers)
+            peer.detector.record(peer.world);
+        const StateHashes hashes = peers[1].world.hashState();
+
+        sf::Packet packet;
+        packet << net::MessageType::Hash << hashes;
+        inFlight.emplace_back(t + config.latencyTicks, std::move(packet));
+
+        while (!inFlight.empty() && inFlight.front().first <= t)
+        {
+            net::MessageType type{};
+            StateHashes remote;
+            if ((inFlight.front().second >> type >> remote) && type == net::MessageType::Hash
+                && !peers[0].detector.compare(remote, std::cout) && peers[0].detector.desyncTick() == remote.tick)
+            {
+                // In netplay this would be a request to the peer for its snapshot.
+                if (const DesyncDetector::Snapshot* theirs = peers[1].detector.snapshot(remote.tick))
+                    peers[0].detector.dump(*theirs, std::cout);
+            }
+            inFlight.pop_front();
+        }
+    }
+
+    // A single hash is far below sf::Clock's microsecond resolution, so time a batch.
+    constexpr int Repeats = 10000;
+    volatile std::uint64_t sink = 0;
+    sf::Clock clock;
+    for (int i = 0; i < Repeats; ++i)
+        sink = sink ^ peers[0].world.hashState().combined();
+    const float hashUs = clock.restart().asSeconds() * 1000000.f / Repeats;
+
+    DesyncDetector scratch;
+    for (int i = 0; i < Repeats; ++i)
+        scratch.record(peers[0].world);
+    const float recordUs = clock.getElapsedTime().asSeconds() * 1000000.f / Repeats;
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Desync check: " << ticks << " ticks, " << peers[0].world.enemies().size() << " enemies, hash "
+              << hashUs << " us/tick, record (hash + snapshot) " << recordUs << " us/tick, "
+              << (peers[0].detector.desyncTick() ? "DESYNC" : "in sync") << std::endl;
+    return peers[0].detector.desyncTick() ? 1 : 0;
+}
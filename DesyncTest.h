@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+struct DesyncConfig
+{
+    float seconds = 30.f;
+    std::uint32_t desyncAt = 0;         // tick at which the second peer misses an event; 0 for none
+    std::uint32_t latencyTicks = 3;     // how late the peer's hashes arrive
+};
+
+// Runs two peers in lockstep on the same inputs. They exchange StateHashes
+// packets every tick and check each other with DesyncDetector. On a
+// mismatch, the diff is printed. Also reports how long hashing takes per tick.
+// Returns 1 if the peers drifted apart, so scripts can check the result.
+int runDesyncTest(const DesyncConfig& config);
@@ -0,0 +1,236 @@
+#include "EnemyStore.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float Gravity = 1400.f;
+    constexpr float Pi = 3.14159265f;
+
+    // Parabolic sine for [-pi, pi], good to about 0.1%. std::sin would stop
+    // the flyer loop from vectorizing on compilers without a vector math library.
+    float fastSin(float x)
+    {
+        const float y = (4.f / Pi) * x - (4.f / (Pi * Pi)) * x * std::abs(x);
+        return 0.225f * (y * std::abs(y) - y) + y;
+    }
+
+    template <typename T>
+    void removeSwap(std::vector<T>& column, std::size_t i)
+    {
+        column[i] = column.back();
+        column.pop_back();
+    }
+}
+
+void EnemyStore::Batch::removeSwap(std::size_t i)
+{
+    ::removeSwap(x, i);
+    ::removeSwap(y, i);
+    ::removeSwap(vx, i);
+    ::removeSwap(vy, i);
+    ::removeSwap(width, i);
+    ::removeSwap(height, i);
+    ::removeSwap(baseY, i);
+    ::removeSwap(phase, i);
+    ::removeSwap(speed, i);
+    ::removeSwap(param, i);
+    ::removeSwap(frequency, i);
+    ::removeSwap(timer, i);
+    ::removeSwap(type, i);
+}
+
+void EnemyStore::spawn(std::uint8_t type, float x, float floorY, bool facingRight)
+{
+    if (type >= EnemyTypes.size())
+        type = 0;
+    const EnemyType& t = EnemyTypes[type];
+    Batch& b = batch(t.archetype);
+
+    const bool paces = t.archetype == EnemyArchetype::Walker || t.archetype == EnemyArchetype::Hopper
+        || t.archetype == EnemyArchetype::Flyer;
+    const float y = floorY - t.size.y - t.spawnHeight;
+
+    b.x.push_back(x);
+    b.y.push_back(y);
+    b.vx.push_back(paces ? (facingRight ? t.speed : -t.speed) : 0.f);
+    b.vy.push_back(0.f);
+    b.width.push_back(t.size.x);
+    b.height.push_back(t.size.y);
+    b.baseY.push_back(y);
+    b.phase.push_back(0.f);
+    b.speed.push_back(t.speed);
+    b.param.push_back(t.param);
+    b.frequency.push_back(t.frequency);
+    b.timer.push_back(t.throwTicks);
+    b.type.push_back(type);
+}
+
+void EnemyStore::update(float dt, sf::Vector2f target, float levelWidth, std::vector<EnemyThrow>& thrown)
+{
+    updateWalkers(batch(EnemyArchetype::Walker), dt, levelWidth);
+    updateHoppers(batch(EnemyArchetype::Hopper), dt, levelWidth);
+    updateFlyers(batch(EnemyArchetype::Flyer), dt);
+    updateHoming(batch(EnemyArchetype::Homing), dt, target);
+    updateThrowers(batch(EnemyArchetype::Thrower), dt, target, thrown);
+}
+
+void EnemyStore::updateWalkers(Batch& b, float dt, float levelWidth)
+{
+    float* x = b.x.data();
+    float* vx = b.vx.data();
+    const float* width = b.width.data();
+    const std::size_t n = b.size();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        x[i] += vx[i] * dt;
+        // Turn around at the ends of the level. Bitwise & and | on purpose:
+        // short-circuiting would put branches in the loop and stop it vectorizing.
+        const bool turn = ((x[i] < 0.f) & (vx[i] < 0.f)) | ((x[i] + width[i] > levelWidth) & (vx[i] > 0.f));
+        vx[i] = turn ? -vx[i] : vx[i];
+    }
+}
+
+void EnemyStore::updateHoppers(Batch& b, float dt, float levelWidth)
+{
+    updateWalkers(b, dt, levelWidth);
+
+    float* y = b.y.data();
+    float* vy = b.vy.data();
+    const float* baseY = b.baseY.data();
+    const float* hopSpeed = b.param.data();
+    const std::size_t n = b.size();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        // plain locals, so both sides of each select are loaded unconditionally
+        const float ground = baseY[i];
+        const float hop = -hopSpeed[i];
+        const float v = vy[i] + Gravity * dt;
+        const float next = y[i] + v * dt;
+        const bool landed = next >= ground;
+        y[i] = landed ? ground : next;
+        vy[i] = landed ? hop : v;
+    }
+}
+
+void EnemyStore::updateFlyers(Batch& b, float dt)
+{
+    float* x = b.x.data();
+    float* y = b.y.data();
+    float* vy = b.vy.data();
+    float* phase = b.phase.data();
+    const float* vx = b.vx.data();
+    const float* baseY = b.baseY.data();
+    const float* amplitude = b.param.data();
+    const float* frequency = b.frequency.data();
+    const std::size_t n = b.size();
+
+    // Flyers go straight on; World drops them once they have left the level.
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        x[i] += vx[i] * dt;
+        // wrap by subtracting a selected constant; a conditional subtraction wouldn't if-convert
+        float p = phase[i] + frequency[i] * dt;
+        p -= p > Pi ? 2.f * Pi : 0.f;
+        phase[i] = p;
+        const float newY = baseY[i] + amplitude[i] * fastSin(p);
+        vy[i] = (newY - y[i]) / dt;
+        y[i] = newY;
+    }
+}
+
+void EnemyStore::updateHoming(Batch& b, float dt, sf::Vector2f target)
+{
+    float* x = b.x.data();
+    float* y = b.y.data();
+    float* vx = b.vx.data();
+    float* vy = b.vy.data();
+    const float* width = b.width.data();
+    const float* height = b.height.data();
+    const float* speed = b.speed.data();
+    const float* turnRate = b.param.data();
+    const std::size_t n = b.size();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float dx = target.x - (x[i] + width[i] * 0.5f);
+        const float dy = target.y - (y[i] + height[i] * 0.5f);
+        const float scale = speed[i] / (std::sqrt(dx * dx + dy * dy) + 0.001f);
+        // ease the velocity towards the direct line, so they swing wide and can be dodged
+        const float k = std::min(turnRate[i] * dt, 1.f);
+        vx[i] += (dx * scale - vx[i]) * k;
+        vy[i] += (dy * scale - vy[i]) * k;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+}
+
+void EnemyStore::updateThrowers(Batch& b, float dt, sf::Vector2f target, std::vector<EnemyThrow>& thrown)
+{
+    float* x = b.x.data();
+    float* vx = b.vx.data();
+    std::int32_t* timer = b.timer.data();
+    const float* width = b.width.data();
+    const float* speed = b.speed.data();
+    const std::size_t n = b.size();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float dx = target.x - (x[i] + width[i] * 0.5f);
+        vx[i] = std::clamp(dx * 2.f, -speed[i], speed[i]);
+        x[i] += vx[i] * dt;
+        timer[i] -= 1;
+    }
+
+    // Throws are rare, so they get a separate scalar pass instead of a branch in the loop above.
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (timer[i] > 0)
+            continue;
+        const EnemyType& t = EnemyTypes[b.type[i]];
+        timer[i] = t.throwTicks;
+
+        sf::Vector2f velocity = t.throwVelocity;
+        if (target.x < x[i] + width[i] * 0.5f)
+            velocity.x = -velocity.x;
+        thrown.push_back({ { x[i] + width[i] * 0.5f, b.y[i] }, velocity, b.type[i] });
+    }
+}
+
+std::size_t EnemyStore::size() const
+{
+    std::size_t total = 0;
+    for (const Batch& b : m_batches)
+        total += b.size();
+    return total;
+}
+
+EnemyState EnemyStore::operator[](std::size_t index) const
+{
+    for (const Batch& b : m_batches)
+    {
+        if (index < b.size())
+            return b.state(index);
+        index -= b.size();
+    }
+    return {};
+}
+
+void EnemyStore::hash(StateHasher& hasher) const
+{
+    for (const Batch& b : m_batches)
+    {
+        hasher.add(static_cast<std::uint64_t>(b.size()));
+        for (std::size_t i = 0; i < b.size(); ++i)
+        {
+            hasher.add(sf::Vector2f(b.x[i], b.y[i]));
+            hasher.add(sf::Vector2f(b.vx[i], b.vy[i]));
+            hasher.add(b.phase[i]);
+            hasher.add(static_cast<std::uint32_t>(b.timer[i]));
+            hasher.add(b.type[i]);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "EnemyTypes.h"
+#include "StateHash.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One enemy as a plain record, for spawning, network transfer and debugging.
+// The store itself doesn't keep enemies like this.
+struct EnemyState
+{
+    sf::Vector2f position;
+    sf::Vector2f velocity;
+    std::uint8_t type = 0;
+};
+
+// Something a Thrower let go of this tick, for the projectile system.
+struct EnemyThrow
+{
+    sf::Vector2f position;
+    sf::Vector2f velocity;
+    std::uint8_t type = 0;          // enemy type that threw it
+};
+
+// All live enemies, grouped by archetype, each group stored column-wise.
+// An archetype's update is a plain loop over float arrays. It has no
+// per-enemy branching on type and no virtual calls, so compilers vectorize
+// it. Per-type tuning is copied into the columns at spawn time, so the loops
+// never look anything up.
+class EnemyStore
+{
+public:
+    struct Batch
+    {
+        std::vector<float> x, y, vx, vy;
+        std::vector<float> width, height;
+        std::vector<float> baseY;           // ground line for hoppers, cruise height for flyers
+        std::vector<float> phase;           // flyer bob angle
+        std::vector<float> speed;
+        std::vector<float> param;           // see EnemyType::param
+        std::vector<float> frequency;
+        std::vector<std::int32_t> timer;    // thrower countdown
+        std::vector<std::uint8_t> type;
+
+        std::size_t size() const { return x.size(); }
+        EnemyState state(std::size_t i) const { return { { x[i], y[i] }, { vx[i], vy[i] }, type[i] }; }
+        void removeSwap(std::size_t i);
+    };
+
+    // floorY is the floor surface; the enemy's feet go there, or spawnHeight above it.
+    void spawn(std::uint8_t type, float x, float floorY, bool facingRight);
+
+    // target is where Homing and Thrower enemies aim for, normally the player's centre.
+    void update(float dt, sf::Vector2f target, float levelWidth, std::vector<EnemyThrow>& thrown);
+
+    std::size_t size() const;
+    bool empty() const { return size() == 0; }
+
+    // Flat index over every batch, archetype order. Fine for reporting; loops should go batch by batch.
+    EnemyState operator[](std::size_t index) const;
+
+    Batch& batch(EnemyArchetype archetype) { return m_batches[static_cast<std::size_t>(archetype)]; }
+    const Batch& batch(EnemyArchetype archetype) const { return m_batches[static_cast<std::size_t>(archetype)]; }
+
+    void hash(StateHasher& hasher) const;
+
+private:
+    void updateWalkers(Batch& b, float dt, float levelWidth);
+    void updateHoppers(Batch& b, float dt, float levelWidth);
+    void updateFlyers(Batch& b, float dt);
+    void updateHoming(Batch& b, float dt, sf::Vector2f target);
+    void updateThrowers(Batch& b, float dt, sf::Vector2f target, std::vector<EnemyThrow>& thrown);
+
+    std::array<Batch, EnemyArchetypeCount> m_batches;
+};
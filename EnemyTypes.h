@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ProjectileTypes.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// How an enemy moves. Each archetype has one update loop in EnemyStore;
+// enemy types are just rows of numbers that pick an archetype and tune it.
+enum class EnemyArchetype : std::uint8_t
+{
+    Walker,     // paces along the ground, turning at the level edges
+    Hopper,     // walker that keeps bouncing
+    Flyer,      // straight line, optionally bobbing on a sine wave
+    Homing,     // steers towards the player
+    Thrower,    // keeps level with the player and lobs something on a timer
+    Count
+};
+
+constexpr std::size_t EnemyArchetypeCount = static_cast<std::size_t>(EnemyArchetype::Count);
+
+struct EnemyType
+{
+    const char* name;
+    EnemyArchetype archetype;
+    sf::Vector2f size;
+    float speed;                    // pixels per second
+    float param;                    // hop speed (Hopper), bob amplitude (Flyer), turn rate (Homing)
+    float frequency;                // bob speed in radians per second (Flyer)
+    float spawnHeight;              // how far above the ground it appears
+    std::uint16_t throwTicks;       // Thrower: ticks between throws
+    sf::Vector2f throwVelocity;     // Thrower: launch velocity, mirrored when facing left
+    ProjectileKind projectile;      // Thrower: what it throws
+    bool stompable;
+};
+
+// The roster. EnemyState::type is an index into this table, and adding an
+// enemy means adding a row. It is also the order the network sends types in,
+// so only append.
+inline constexpr std::array<EnemyType, 12> EnemyTypes{ {
+    //  name            archetype                 size              speed   param  freq  height throw velocity            projectile                 stomp
+    { "Goomba",       EnemyArchetype::Walker,  { 32.f, 32.f },    60.f,    0.f, 0.f,    0.f,   0, {   0.f,    0.f }, ProjectileKind::Hammer,    true },
+    { "Micro Goomba", EnemyArchetype::Walker,  { 16.f, 16.f },    90.f,    0.f, 0.f,    0.f,   0, {   0.f,    0.f }, ProjectileKind::Hammer,    true },
+    { "Grand Goomba", EnemyArchetype::Walker,  { 64.f, 64.f },    40.f,    0.f, 0.f,    0.f,   0, {   0.f,    0.f }, ProjectileKind::Hammer,    true },
+    { "Parakoopa",    EnemyArchetype::Hopper,  { 32.f, 48.f },    60.f,  420.f, 0.f,    0.f,   0, {   0.f,    0.f }, ProjectileKind::Hammer,    true },
+    { "Bullet Bill",  EnemyArchetype::Flyer,   { 32.f, 28.f },   150.f,    0.f, 0.f,   40.f,   0, {   0.f,    0.f }, ProjectileKind::Hammer,    true },
+    { "Missile Bill", EnemyArchetype::Homing,  { 32.f, 28.f },   140.f,    1.5f, 0.f,  40.f,   0, {   0.f,    0.f }, ProjectileKind::Hammer,    true },
+    { "Nipper Plant", EnemyArchetype::Hopper,  { 32.f, 32.f },    30.f,  260.f, 0.f,    0.f,   0, {   0.f,    0.f }, ProjectileKind::Hammer,    false },
+    { "Boo",          EnemyArchetype::Homing,  { 32.f, 32.f },    50.f,    0.8f, 0.f,  60.f,   0, {   0.f,    0.f }, ProjectileKind::Hammer,    false },
+    { "Lakitu",       EnemyArchetype::Thrower, { 32.f, 48.f },   100.f,    0.f, 0.f,  180.f, 150, {  60.f, -240.f }, ProjectileKind::SpinyEgg,  true },
+    { "Sledge Bro",   EnemyArchetype::Thrower, { 48.f, 48.f },    30.f,    0.f, 0.f,    0.f,  90, { 120.f, -400.f }, ProjectileKind::Hammer,    true },
+    { "Fire Chomp",   EnemyArchetype::Homing,  { 32.f, 32.f },    70.f,    1.f, 0.f,   80.f,   0, {   0.f,    0.f }, ProjectileKind::Hammer,    false },
+    { "Cheep",        EnemyArchetype::Flyer,   { 32.f, 32.f },    70.f,   24.f, 3.f,   20.f,   0, {   0.f,    0.f }, ProjectileKind::Hammer,    true },
+} };
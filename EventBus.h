@@ -0,0 +1,51 @@
+#pragma once
+
+#include "SpscQueue.h"
+#include "World.h"
+
+#include <cstddef>
+#include <vector>
+
+// Carries the simulation's GameEvents to whatever presents them, so
+// gameplay never calls into the audio or graphics backends itself. Each
+// consumer has its own channel, since a single-consumer queue can't be
+// shared: audio is drained by the SoundBoard's thread, effects by the
+// render loop. publish() is called once per tick and hands the tick's
+// events over as one batch.
+//
+// The headless build has no consumers, so there the channels don't exist
+// and publishing compiles to nothing.
+class EventBus
+{
+public:
+    static constexpr std::size_t ChannelCapacity = 256;     // events; several ticks' worth
+    using Channel = SpscQueue<GameEvent, ChannelCapacity>;
+
+#ifndef SUPERMARIO_HEADLESS
+    void publish(const std::vector<GameEvent>& events)
+    {
+        if (events.empty())
+            return;
+        for (const GameEvent& event : events)
+        {
+            m_audio.push(event);
+            m_effects.push(event);
+        }
+        m_audio.publish();
+        m_effects.publish();
+    }
+
+    Channel& audio() { return m_audio; }
+    Channel& effects() { return m_effects; }
+
+    // events a consumer fell too far behind to get
+    std::size_t dropped() const { return m_audio.dropped() + m_effects.dropped(); }
+
+private:
+    Channel m_audio;
+    Channel m_effects;
+#else
+    void publish(const std::vector<GameEvent>&) {}
+    std::size_t dropped() const { return 0; }
+#endif
+};
@@ -0,0 +1,71 @@
+#include "FramePacer.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+void FramePacer::presented(Profiler& profiler)
+{
+    const sf::Time now = m_clock.getElapsedTime();
+    if (!m_lastPresent)
+    {
+        m_lastPresent = now;
+        return;
+    }
+
+    const float intervalMs = (now - *m_lastPresent).asSeconds() * 1000.f;
+    m_lastPresent = now;
+
+    m_intervals[m_intervalHead] = intervalMs;
+    m_intervalHead = (m_intervalHead + 1) % WindowSize;
+    m_intervalCount = std::min(m_intervalCount + 1, WindowSize);
+    if (m_intervalHead == 0)
+        estimatePeriod();       // once per window is plenty, the refresh rate rarely changes
+
+    // how many refresh periods this frame stayed on screen
+    const float periods = std::max(1.f, std::round(intervalMs / m_refreshPeriodMs));
+    if (periods > 1.f)
+        m_missedVblanks += static_cast<std::uint64_t>(periods) - 1;
+
+    const float deviation = std::abs(intervalMs - periods * m_refreshPeriodMs);
+    const auto bucket = std::upper_bound(BucketLimitsMs.begin(), BucketLimitsMs.end(), deviation);
+    ++m_histogram[static_cast<std::size_t>(bucket - BucketLimitsMs.begin())];
+
+    if (!m_intervalSeries)
+    {
+        m_intervalSeries = profiler.track("present interval ms");
+        m_missedSeries = profiler.track("missed vblanks");
+    }
+    profiler.record(*m_intervalSeries, intervalMs);
+    profiler.record(*m_missedSeries, periods - 1.f);
+}
+
+void FramePacer::estimatePeriod()
+{
+    std::array<float, WindowSize> sorted = m_intervals;
+    const auto tenth = sorted.begin() + m_intervalCount / 10;
+    std::nth_element(sorted.begin(), tenth, sorted.begin() + m_intervalCount);
+    if (*tenth > 0.f)
+        m_refreshPeriodMs = *tenth;
+}
+
+void FramePacer::report(std::ostream& out) const
+{
+    std::uint64_t total = 0;
+    for (std::uint32_t count : m_histogram)
+        total += count;
+
+    out << std::fixed << std::setprecision(2)
+        << "refresh " << m_refreshPeriodMs << " ms (" << std::setprecision(0) << 1000.f / m_refreshPeriodMs
+        << " Hz), missed vblanks " << m_missedVblanks << '\n'
+        << "jitter";
+    for (std::size_t i = 0; i < BucketCount; ++i)
+    {
+        const float share = total ? 100.f * static_cast<float>(m_histogram[i]) / static_cast<float>(total) : 0.f;
+        out << std::setprecision(1) << "  " << (i < BucketLimitsMs.size() ? "<" : ">=")
+            << (i < BucketLimitsMs.size() ? BucketLimitsMs[i] : BucketLimitsMs.back()) << "ms "
+            << std::setprecision(0) << share << '%';
+    }
+    out << '\n';
+}
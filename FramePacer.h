@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+
+class Profiler;
+
+// Measures how evenly frames reach the screen. Call presented() right after
+// every window.display(). With vsync on, present intervals should sit on
+// whole multiples of the refresh period; anything longer than one period
+// means at least one vblank went by without a new frame.
+class FramePacer
+{
+public:
+    // Jitter buckets: deviation of each present interval from the refresh period.
+    static constexpr std::array<float, 5> BucketLimitsMs{ 0.5f, 1.f, 2.f, 4.f, 8.f };
+    static constexpr std::size_t BucketCount = BucketLimitsMs.size() + 1;
+
+    void presented(Profiler& profiler);
+
+    // Forget the last present, e.g. after sleeping on a static screen, so the
+    // gap doesn't count as a missed frame.
+    void reset() { m_lastPresent.reset(); }
+
+    // Estimated from the shortest recent intervals, which with vsync are one period.
+    float refreshPeriodMs() const { return m_refreshPeriodMs; }
+
+    std::uint64_t missedVblanks() const { return m_missedVblanks; }
+    const std::array<std::uint32_t, BucketCount>& histogram() const { return m_histogram; }
+
+    void report(std::ostream& out) const;
+
+private:
+    static constexpr std::size_t WindowSize = 120;
+
+    void estimatePeriod();
+
+    sf::Clock m_clock;
+    std::optional<sf::Time> m_lastPresent;
+    std::array<float, WindowSize> m_intervals{};
+    std::size_t m_intervalCount = 0;
+    std::size_t m_intervalHead = 0;
+    float m_refreshPeriodMs = 1000.f / 60.f;
+    std::uint64_t m_missedVblanks = 0;
+    std::array<std::uint32_t, BucketCount> m_histogram{};
+    std::optional<std::size_t> m_intervalSeries;
+    std::optional<std::size_t> m_missedSeries;
+};
@@ -0,0 +1,148 @@
+# Generates AssetIds.h from the files under assets/: an AssetId for each file
+# and a constexpr table of their exact paths, formats, sizes and, for images,
+# dimensions. Code names assets by id, so a file that is missing or renamed
+# stops the build instead of failing to load at runtime, and a lookup is an
+# array index.
+#
+# Files are also matched by content. When several hold the same bytes, the
+# one with the shortest path is the blob they all load from, and the others
+# are aliases: they keep their ids, but their path and blob are its, so
+# anything keyed by path or blob loads and keeps the data once.
+#
+# The game's project runs it before compiling whenever a file under assets/
+# (or this script) is added, removed or changed. The header is only
+# rewritten when its text changes, so touching an asset rebuilds nothing
+# else. By hand:
+#
+#   powershell -NoProfile -ExecutionPolicy Bypass -File GenerateAssetIds.ps1
+
+param(
+    [string]$Root = $PSScriptRoot
+)
+
+$ErrorActionPreference = 'Stop'
+Add-Type -AssemblyName System.Drawing
+
+$assetsDir = (Resolve-Path -LiteralPath (Join-Path $Root 'assets')).Path
+$output = Join-Path $Root 'AssetIds.h'
+
+$formats = @{
+    '.png' = 'Png'; '.jpg' = 'Jpeg'; '.jpeg' = 'Jpeg'; '.gif' = 'Gif'
+    '.wav' = 'Wav'; '.mp3' = 'Mp3'; '.ttf' = 'Font'
+}
+$imageFormats = @('Png', 'Jpeg', 'Gif')
+
+# "mario sprites/in-levbel/SMAS-SMB3-SuperLuigiSprite.png" becomes
+# MarioSpritesInLevbelSmasSmb3SuperLuigiSpritePng: split on anything that
+# isn't a letter or digit, each word capitalized, and words in all capitals
+# (SMAS, PNG) lowered after their first letter.
+function Get-AssetName([string]$relative)
+{
+    $words = $relative -split '[^A-Za-z0-9]+' | Where-Object { $_ }
+    $name = -join ($words | ForEach-Object {
+        $rest = if ($_ -cmatch '^[A-Z0-9]+$') { $_.Substring(1).ToLowerInvariant() } else { $_.Substring(1) }
+        $_.Substring(0, 1).ToUpperInvariant() + $rest
+    })
+    if ($name -match '^[0-9]') { $name = 'Asset' + $name }
+    return $name
+}
+
+# the sound step's compressed copies and their stamps are made on each machine, so they aren't listed
+$files = @(Get-ChildItem -LiteralPath $assetsDir -Recurse -File | Where-Object { $_.Extension -notin @('.ogg', '.stamp') })
+$relatives = [string[]]($files | ForEach-Object { $_.FullName.Substring($assetsDir.Length + 1).Replace('\', '/') })
+$sorted = [object[]]$files.Clone()
+[Array]::Sort([string[]]$relatives.Clone(), $sorted, [StringComparer]::Ordinal)
+
+# names, and which file each set of identical bytes is loaded from: the
+# shortest path, so "smb_1-up.wav" rather than "smb_1-up (1).wav"
+$names = @{}       # case-insensitive, so names that differ only in case clash too
+$blobs = @{}       # content hash to the asset whose file holds those bytes
+$assets = foreach ($file in $sorted)
+{
+    $relative = $file.FullName.Substring($assetsDir.Length + 1).Replace('\', '/')
+    $name = Get-AssetName $relative
+    if ($names.ContainsKey($name))
+    {
+        [Console]::Error.WriteLine("Error: assets/$relative and assets/$($names[$name]) would both be AssetId::$name")
+        exit 1
+    }
+    $names[$name] = $relative
+
+    $hash = (Get-FileHash -LiteralPath $file.FullName -Algorithm SHA256).Hash
+    if (-not $blobs.ContainsKey($hash) -or $relative.Length -lt $blobs[$hash].Relative.Length)
+    {
+        $blobs[$hash] = @{ Name = $name; Relative = $relative }
+    }
+    @{ File = $file; Relative = $relative; Name = $name; Hash = $hash }
+}
+
+$duplicateBytes = 0
+$enum = New-Object System.Collections.Generic.List[string]
+$table = New-Object System.Collections.Generic.List[string]
+foreach ($asset in $assets)
+{
+    $file = $asset.File
+    $blob = $blobs[$asset.Hash]
+    $comment = ''
+    if ($blob.Name -cne $asset.Name)
+    {
+        $comment = "    // assets/$($asset.Relative)"
+        $duplicateBytes += $file.Length
+    }
+
+    $format = $formats[$file.Extension.ToLowerInvariant()]
+    if (-not $format) { $format = 'Other' }
+    $width = 0
+    $height = 0
+    if ($imageFormats -contains $format)
+    {
+        $image = [System.Drawing.Image]::FromFile($file.FullName)
+        try { $width = $image.Width; $height = $image.Height } finally { $image.Dispose() }
+    }
+
+    $enum.Add("    $($asset.Name),")
+    $table.Add("    { `"assets/$($blob.Relative)`", AssetId::$($blob.Name), AssetFormat::$format, $width, $height, $($file.Length) },$comment")
+}
+
+$lines = @(
+    '// Generated by GenerateAssetIds.ps1 from the files under assets/. Don''t'
+    '// edit it by hand; the game''s pre-build step regenerates it.'
+    '#pragma once'
+    ''
+    '#include <array>'
+    '#include <cstddef>'
+    '#include <cstdint>'
+    ''
+    'enum class AssetFormat : std::uint8_t { Png, Jpeg, Gif, Wav, Mp3, Font, Other };'
+    ''
+    'enum class AssetId : std::uint16_t'
+    '{'
+) + $enum.ToArray() + @(
+    '    Count'
+    '};'
+    ''
+    'struct AssetInfo'
+    '{'
+    '    const char* path;           // as on disk, case and all, from the working directory'
+    '    AssetId blob;               // the asset whose file is loaded for these bytes'
+    '    AssetFormat format;'
+    '    std::uint16_t width;        // images only'
+    '    std::uint16_t height;'
+    '    std::uint32_t bytes;'
+    '};'
+    ''
+    '// By AssetId.'
+    'inline constexpr std::array<AssetInfo, static_cast<std::size_t>(AssetId::Count)> Assets{ {'
+) + $table.ToArray() + @(
+    '} };'
+    ''
+    'constexpr const AssetInfo& asset(AssetId id) { return Assets[static_cast<std::size_t>(id)]; }'
+)
+$text = ($lines -join "`n") + "`n"
+
+if ((Test-Path -LiteralPath $output) -and ([System.IO.File]::ReadAllText($output).Replace("`r`n", "`n") -ceq $text))
+{
+    exit 0
+}
+[System.IO.File]::WriteAllText($output, $text.Replace("`n", "`r`n"), (New-Object System.Text.UTF8Encoding $false))
+Write-Host "Generated AssetIds.h ($($enum.Count) assets, $($blobs.Count) unique, $duplicateBytes bytes in duplicates)"
@@ -0,0 +1,71 @@
+#include "IdleController.h"
+
+void IdleController::setStatic(bool isStatic)
+{
+    if (m_static == isStatic)
+        return;
+    m_static = isStatic;
+    m_redrawAt.reset();
+    m_dirty = true;
+}
+
+void IdleController::scheduleRedraw(sf::Time delay)
+{
+    const sf::Time at = m_clock.getElapsedTime() + delay;
+    if (!m_redrawAt || at < *m_redrawAt)
+        m_redrawAt = at;
+}
+
+std::optional<sf::Event> IdleController::nextEvent(sf::Window& window)
+{
+    if (!isSuspended() && (!m_static || m_dirty))
+        return window.pollEvent();
+
+    // Static or suspended: sleep in the OS until something happens. The
+    // timeout wakes us for the next animation timer; while suspended it is
+    // only a safety net in case a focus event gets lost.
+    sf::Time timeout = sf::seconds(SuspendedWakeSeconds);
+    if (!isSuspended() && m_redrawAt)
+    {
+        timeout = *m_redrawAt - m_clock.getElapsedTime();
+        if (timeout <= sf::Time::Zero)
+        {
+            m_redrawAt.reset();
+            m_dirty = true;
+            return window.pollEvent();
+        }
+    }
+
+    std::optional<sf::Event> event = window.waitEvent(timeout);
+    if (!event && m_redrawAt && m_clock.getElapsedTime() >= *m_redrawAt)
+    {
+        m_redrawAt.reset();
+        m_dirty = true;
+    }
+    return event;
+}
+
+void IdleController::handleEvent(const sf::Event& event)
+{
+    if (event.is<sf::Event::FocusLost>())
+        m_focused = false;
+    else if (event.is<sf::Event::FocusGained>())
+        m_focused = true;
+    else if (const auto* resized = event.getIf<sf::Event::Resized>())
+        m_minimized = resized->size.x == 0 || resized->size.y == 0;
+
+    // any event may change what is on screen (input, expose, resize, ...)
+    m_dirty = true;
+}
+
+bool IdleController::shouldRender() const
+{
+    if (isSuspended())
+        return false;
+    return !m_static || m_dirty;
+}
+
+void IdleController::markRendered()
+{
+    m_dirty = false;
+}
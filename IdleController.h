@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Window.hpp>
+#include <optional>
+
+// Decides when the main loop may sleep instead of redrawing.
+//
+// Active scenes poll and redraw every frame as before. A static scene (pause,
+// title, map) only redraws after input, a window event or its next animation
+// timer, and blocks in waitEvent() in between. While the window is unfocused
+// or minimized rendering stops altogether.
+class IdleController
+{
+public:
+    // Scene has nothing animating by itself. Leaving static mode redraws at once.
+    void setStatic(bool isStatic);
+    bool isStatic() const { return m_static; }
+
+    // Static scenes: redraw again after this delay, e.g. the next blink of a label.
+    // Only the earliest pending deadline is kept.
+    void scheduleRedraw(sf::Time delay);
+
+    void invalidate() { m_dirty = true; }
+
+    // Use as the first event of the frame's event loop:
+    //     for (auto event = idle.nextEvent(window); event; event = window.pollEvent())
+    // Blocks only when there is nothing to draw yet.
+    std::optional<sf::Event> nextEvent(sf::Window& window);
+
+    // Feed every window event through here.
+    void handleEvent(const sf::Event& event);
+
+    bool isSuspended() const { return !m_focused || m_minimized; }
+    bool shouldRender() const;
+    void markRendered();
+
+private:
+    static constexpr float SuspendedWakeSeconds = 0.5f;
+
+    sf::Clock m_clock;
+    std::optional<sf::Time> m_redrawAt;
+    bool m_static = false;
+    bool m_dirty = true;
+    bool m_focused = true;
+    bool m_minimized = false;
+};
@@ -0,0 +1,82 @@
+#include "ImageBenchmark.h"
+#include "ImageCache.h"
+#include "ImageLoader.h"
+#include "ThreadPool.h"
+
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+int runImageBenchmark(const ImageBenchmarkConfig& config)
+{
+    std::vector<sf::Texture> textures(config.images.size());
+    bool ok = true;
+
+    sf::Time decode = sf::Time::Zero;
+    for (int r = 0; r < std::max(1, config.repeats); ++r)
+    {
+        sf::Clock clock;
+        for (std::size_t i = 0; i < config.images.size(); ++i)
+            ok = textures[i].loadFromFile(config.images[i]) && ok;
+        const sf::Time elapsed = clock.getElapsedTime();
+        decode = r == 0 ? elapsed : std::min(decode, elapsed);
+    }
+
+    // each cold run starts from an empty cache
+    std::error_code error;
+    sf::Time cold = sf::Time::Zero;
+    for (int r = 0; r < std::max(1, config.repeats); ++r)
+    {
+        std::filesystem::remove_all(config.cacheDirectory, error);
+        ImageCache cache(config.cacheDirectory);
+        sf::Clock clock;
+        for (std::size_t i = 0; i < config.images.size(); ++i)
+            ok = cache.loadTexture(textures[i], config.images[i]) && ok;
+        const sf::Time elapsed = clock.getElapsedTime();
+        cold = r == 0 ? elapsed : std::min(cold, elapsed);
+    }
+
+    // the same cold start with the decoding spread over the pool, as the game does it
+    ThreadPool pool;
+    sf::Time parallel = sf::Time::Zero;
+    for (int r = 0; r < std::max(1, config.repeats); ++r)
+    {
+        std::filesystem::remove_all(config.cacheDirectory, error);
+        ImageCache cache(config.cacheDirectory);
+        ImageLoader loader(cache, pool);
+        sf::Clock clock;
+        for (std::size_t i = 0; i < config.images.size(); ++i)
+            loader.add(textures[i], config.images[i]);
+        ok = loader.prepare() && ok;
+        while (!loader.upload(static_cast<std::size_t>(-1)))
+            ;
+        const sf::Time elapsed = clock.getElapsedTime();
+        parallel = r == 0 ? elapsed : std::min(parallel, elapsed);
+    }
+
+    sf::Time warm = sf::Time::Zero;
+    for (int r = 0; r < std::max(1, config.repeats); ++r)
+    {
+        ImageCache cache(config.cacheDirectory);
+        sf::Clock clock;
+        for (std::size_t i = 0; i < config.images.size(); ++i)
+            ok = cache.loadTexture(textures[i], config.images[i]) && ok;
+        const sf::Time elapsed = clock.getElapsedTime();
+        warm = r == 0 ? elapsed : std::min(warm, elapsed);
+        ok = ok && cache.stats().hits == config.images.size();
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Images: " << config.images.size() << " files, best of " << config.repeats << "\n"
+              << "  decode every launch  " << decode.asSeconds() * 1000.f << " ms\n"
+              << "  cache, cold          " << cold.asSeconds() * 1000.f << " ms (decode + write entries)\n"
+              << "  cache, cold, " << std::setw(2) << pool.threadCount() << " thr  " << parallel.asSeconds() * 1000.f << " ms, "
+              << cold.asSeconds() / std::max(parallel.asSeconds(), 1e-6f) << "x faster than one thread\n"
+              << "  cache, warm          " << warm.asSeconds() * 1000.f << " ms, "
+              << decode.asSeconds() / std::max(warm.asSeconds(), 1e-6f) << "x faster than decoding\n"
+              << "  " << (ok ? "every warm load came from the cache" : "some images failed or missed the cache") << std::endl;
+    return ok ? 0 : 1;
+}
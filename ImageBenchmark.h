@@ -0,0 +1,28 @@
+#pragma once
+
+#include "AssetIds.h"
+
+#include <filesystem>
+#include <vector>
+
+struct ImageBenchmarkConfig
+{
+    // What the game loads at startup, plus the larger backgrounds waiting to be used.
+    std::vector<std::filesystem::path> images{
+        asset(AssetId::MariobackgroundPng).path,
+        asset(AssetId::MarioPng).path,
+        asset(AssetId::MarioSpritesInLevbelSmasSmb3SuperLuigiSpritePng).path,
+        asset(AssetId::Mariobackground2Png).path,
+        asset(AssetId::Mariobackground3Png).path,
+        asset(AssetId::Background2Jpg).path,
+    };
+    std::filesystem::path cacheDirectory = "cache/image-bench";
+    int repeats = 3;                // best run is reported
+};
+
+// supermario --image-bench: loads the images into textures the way the game
+// used to, decoding each file, and through an ImageCache: once cold, which
+// decodes and writes the entries, cold again with the decoding spread over a
+// ThreadPool through an ImageLoader, then warm. Prints the time for each.
+// Returns 1 if an image failed to load or a warm load missed the cache.
+int runImageBenchmark(const ImageBenchmarkConfig& config);
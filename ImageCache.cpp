@@ -0,0 +1,172 @@
+#include "ImageCache.h"
+#include "StateHash.h"
+
+#include <SFML/Graphics/Image.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr std::uint32_t EntryMagic = 0x43494D53;    // "SMIC"
+    constexpr std::uint32_t EntryVersion = 1;
+
+    struct EntryHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint64_t sourceSize;
+        std::int64_t sourceTime;
+        std::uint64_t sourceHash;
+    };
+
+    std::uint64_t hashBytes(const std::uint8_t* data, std::size_t size)
+    {
+        StateHasher hasher(size);
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, sizeof word);
+            hasher.add(word);
+        }
+        std::uint64_t tail = 0;
+        if (i < size)
+            std::memcpy(&tail, data + i, size - i);
+        hasher.add(tail);
+        return hasher.finish();
+    }
+
+    std::int64_t modificationTime(const std::filesystem::path& path, std::error_code& error)
+    {
+        return static_cast<std::int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+    }
+
+    // Replaces the entry in one step, so a crash mid-write never leaves half of one behind.
+    void writeEntry(const std::filesystem::path& path, const EntryHeader& header, const std::uint8_t* pixels)
+    {
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(&header), sizeof header);
+            out.write(reinterpret_cast<const char*>(pixels), std::streamsize{ header.width } * header.height * 4);
+            if (!out)
+                return;
+        }
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if (error)
+            std::filesystem::remove(temporary, error);
+    }
+}
+
+ImageCache::ImageCache(std::filesystem::path directory) :
+    m_directory(std::move(directory))
+{
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+}
+
+std::filesystem::path ImageCache::entryPath(const std::filesystem::path& image) const
+{
+    const std::string key = image.generic_string();
+    char name[24];
+    std::snprintf(name, sizeof name, "%016llx.rgba",
+                  static_cast<unsigned long long>(hashBytes(reinterpret_cast<const std::uint8_t*>(key.data()), key.size())));
+    return m_directory / name;
+}
+
+ImageCache::Stats ImageCache::stats() const
+{
+    return { m_hits.load(), m_touched.load(), m_misses.load(), m_stale.load() };
+}
+
+bool ImageCache::loadTexture(sf::Texture& texture, const std::filesystem::path& path)
+{
+    PreparedImage image;
+    if (!prepare(path, image) || !texture.resize(image.size()))
+        return false;
+    texture.update(image.pixels());
+    return true;
+}
+
+bool ImageCache::prepare(const std::filesystem::path& path, PreparedImage& image)
+{
+    std::error_code error;
+    const std::uint64_t size = std::filesystem::file_size(path, error);
+    const std::int64_t time = error ? 0 : modificationTime(path, error);
+    if (error)
+    {
+        std::cerr << "Error: Failed to open " << path.string() << std::endl;
+        return false;
+    }
+
+    const std::filesystem::path entry = entryPath(path);
+    std::vector<std::uint8_t> source;
+    std::uint64_t sourceHash = 0;
+    auto readSource = [&]
+    {
+        std::ifstream file(path, std::ios::binary);
+        source.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        sourceHash = hashBytes(source.data(), source.size());
+    };
+
+    const bool hadEntry = image.m_mapped.open(entry);
+    if (hadEntry)
+    {
+        const MappedFile& mapped = image.m_mapped;
+        EntryHeader header{};
+        if (mapped.size() >= sizeof header)
+            std::memcpy(&header, mapped.data(), sizeof header);
+        const bool valid = header.magic == EntryMagic && header.version == EntryVersion
+            && mapped.size() == sizeof header + std::size_t{ header.width } * header.height * 4;
+
+        bool fresh = valid && header.sourceSize == size && header.sourceTime == time;
+        if (valid && !fresh)
+        {
+            // touched, maybe not changed: only the hash can tell
+            readSource();
+            fresh = sourceHash == header.sourceHash;
+            if (fresh)
+            {
+                // remember the new time, so the next launch doesn't hash it again
+                ++m_touched;
+                header.sourceSize = size;
+                header.sourceTime = time;
+                std::fstream out(entry, std::ios::binary | std::ios::in | std::ios::out);
+                out.write(reinterpret_cast<const char*>(&header), sizeof header);
+            }
+        }
+        if (fresh)
+        {
+            ++m_hits;
+            image.m_size = { header.width, header.height };
+            image.m_pixels = mapped.data() + sizeof header;
+            return true;
+        }
+        image.m_mapped.close();     // it's about to be replaced
+    }
+
+    // decode, and store the result for next time
+    if (source.empty())
+        readSource();
+    if (!image.m_image.loadFromMemory(source.data(), source.size()))
+    {
+        std::cerr << "Error: Failed to load " << path.string() << std::endl;
+        return false;
+    }
+    ++(hadEntry ? m_stale : m_misses);
+    image.m_size = image.m_image.getSize();
+    image.m_pixels = image.m_image.getPixelsPtr();
+    writeEntry(entry, { EntryMagic, EntryVersion, image.m_size.x, image.m_size.y, size, time, sourceHash },
+               image.m_pixels);
+    return true;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// An image ready for the GPU: its pixels either mapped from a cache entry or
+// freshly decoded, and kept alive until this is destroyed.
+class PreparedImage
+{
+public:
+    sf::Vector2u size() const { return m_size; }
+    const std::uint8_t* pixels() const { return m_pixels; }     // RGBA rows, top first
+
+private:
+    friend class ImageCache;
+
+    MappedFile m_mapped;
+    sf::Image m_image;
+    sf::Vector2u m_size;
+    const std::uint8_t* m_pixels = nullptr;
+};
+
+// Keeps decoded copies of images on disk, so later launches skip PNG and
+// JPEG decoding. Each entry is a small header plus the raw RGBA pixels, ready
+// for the GPU: a warm load maps the entry and passes the mapping straight
+// to sf::Texture::update, with no decoding and no copy of our own.
+//
+// An entry is found by its image's path and remembers the size, modification
+// time and content hash of the file it was decoded from. If the size and
+// time still match, it is used as is. If not, the file is hashed: an equal
+// hash means it was only touched, and the entry is kept; anything else
+// means it changed, and the entry is rebuilt. Stale entries never need
+// clearing by hand.
+class ImageCache
+{
+public:
+    struct Stats
+    {
+        std::size_t hits = 0;       // loaded from the cache
+        std::size_t touched = 0;    // hits whose file had to be hashed first
+        std::size_t misses = 0;     // decoded, no entry yet
+        std::size_t stale = 0;      // decoded, the entry was out of date
+    };
+
+    explicit ImageCache(std::filesystem::path directory = "cache/images");
+
+    // Loads path into texture like sf::Texture::loadFromFile. Failing to
+    // write the cache isn't an error, the image is just decoded next time too.
+    bool loadTexture(sf::Texture& texture, const std::filesystem::path& path);
+
+    // The part of loadTexture that needs no GPU: safe to call for different
+    // images from several threads at once (see ImageLoader).
+    bool prepare(const std::filesystem::path& path, PreparedImage& image);
+
+    Stats stats() const;
+    const std::filesystem::path& directory() const { return m_directory; }
+
+private:
+    std::filesystem::path entryPath(const std::filesystem::path& image) const;
+
+    std::filesystem::path m_directory;
+    std::atomic<std::size_t> m_hits{ 0 };
+    std::atomic<std::size_t> m_touched{ 0 };
+    std::atomic<std::size_t> m_misses{ 0 };
+    std::atomic<std::size_t> m_stale{ 0 };
+};
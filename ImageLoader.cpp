@@ -0,0 +1,88 @@
+#include "ImageLoader.h"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+ImageLoader::ImageLoader(ImageCache& cache, ThreadPool& pool) :
+    m_cache(cache),
+    m_pool(pool)
+{
+}
+
+void ImageLoader::add(sf::Texture& texture, std::filesystem::path path)
+{
+    m_jobs.push_back({ &texture, std::move(path), nullptr });
+}
+
+bool ImageLoader::prepare()
+{
+    const std::size_t first = m_prepared;
+    const std::size_t count = m_jobs.size() - first;
+    std::vector<char> ok(count, 0);
+    for (std::size_t i = first; i < m_jobs.size(); ++i)
+        m_jobs[i].image = std::make_unique<PreparedImage>();
+
+    // one image per slice when there are enough threads, which there usually are
+    m_pool.parallelFor(count, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            ok[i] = m_cache.prepare(m_jobs[first + i].path, *m_jobs[first + i].image);
+    });
+
+    // textures are GPU objects, so sizing them stays on this thread
+    bool all = true;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Job& job = m_jobs[first + i];
+        if (!ok[i] || !job.texture->resize(job.image->size()))
+        {
+            if (ok[i])
+                std::cerr << "Error: Failed to create texture for " << job.path.string() << std::endl;
+            job.image.reset();
+            job.done = true;
+            all = false;
+        }
+    }
+    m_prepared = m_jobs.size();
+    return all;
+}
+
+bool ImageLoader::upload(std::size_t maxBytes)
+{
+    std::size_t sent = 0;
+    while (m_nextUpload < m_prepared && sent < maxBytes)
+    {
+        Job& job = m_jobs[m_nextUpload];
+        if (job.done)
+        {
+            ++m_nextUpload;
+            continue;
+        }
+
+        const sf::Vector2u size = job.image->size();
+        const std::size_t rowBytes = std::size_t{ size.x } * 4;
+        const std::size_t budgetRows = std::max<std::size_t>(1, (maxBytes - sent) / std::max<std::size_t>(rowBytes, 1));
+        const auto rows = static_cast<unsigned int>(std::min<std::size_t>(budgetRows, size.y - job.nextRow));
+        if (rows > 0)
+            job.texture->update(job.image->pixels() + job.nextRow * rowBytes, { size.x, rows }, { 0, job.nextRow });
+        job.nextRow += rows;
+        sent += rows * rowBytes;
+
+        if (job.nextRow >= size.y)
+        {
+            job.image.reset();
+            job.done = true;
+            ++m_nextUpload;
+        }
+    }
+    return m_nextUpload == m_prepared;
+}
+
+bool ImageLoader::uploaded(const sf::Texture& texture) const
+{
+    for (const Job& job : m_jobs)
+        if (job.texture == &texture)
+            return job.done;
+    return false;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ImageCache.h"
+#include "ThreadPool.h"
+
+#include <SFML/Graphics/Texture.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+// Loads a set of images into textures in two steps. prepare() decodes them,
+// or maps them from the cache, all at once across a ThreadPool; SFML
+// decodes a PNG or JPEG in one piece, so the parallelism is between images,
+// not within one. upload() then sends them to the GPU in strips of rows, in
+// the order they were added, up to a byte budget per call. So a big
+// background can go up over a few frames instead of stalling one.
+class ImageLoader
+{
+public:
+    ImageLoader(ImageCache& cache, ThreadPool& pool);
+
+    // texture must outlive the loader, or at least the upload.
+    void add(sf::Texture& texture, std::filesystem::path path);
+
+    // Prepares everything added since the last call and sizes the textures,
+    // so their sizes can be used before they are uploaded. False if any
+    // image failed to load; the rest still go ahead.
+    bool prepare();
+
+    // Uploads about maxBytes of prepared pixels, at least one row. True once
+    // everything prepared so far is on the GPU.
+    bool upload(std::size_t maxBytes);
+    bool uploaded(const sf::Texture& texture) const;
+
+private:
+    struct Job
+    {
+        sf::Texture* texture;
+        std::filesystem::path path;
+        std::unique_ptr<PreparedImage> image;      // released once uploaded
+        unsigned int nextRow = 0;
+        bool done = false;
+    };
+
+    ImageCache& m_cache;
+    ThreadPool& m_pool;
+    std::vector<Job> m_jobs;
+    std::size_t m_prepared = 0;     // jobs before this have been through prepare()
+    std::size_t m_nextUpload = 0;
+};
@@ -0,0 +1,214 @@
+#include "Input.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    // The arrow keys as directions: player 1's in split screen, player 0's too when alone.
+    constexpr std::array<std::pair<Action, sf::Keyboard::Scancode>, 4> ArrowKeys{ {
+        { Action::Left, sf::Keyboard::Scancode::Left },
+        { Action::Right, sf::Keyboard::Scancode::Right },
+        { Action::Up, sf::Keyboard::Scancode::Up },
+        { Action::Down, sf::Keyboard::Scancode::Down },
+    } };
+}
+
+Binding Binding::key(sf::Keyboard::Scancode code)
+{
+    Binding b;
+    b.kind = Kind::Key;
+    b.scancode = code;
+    return b;
+}
+
+Binding Binding::joystickButton(unsigned int joystick, unsigned int button)
+{
+    Binding b;
+    b.kind = Kind::JoystickButton;
+    b.joystick = joystick;
+    b.button = button;
+    return b;
+}
+
+Binding Binding::joystickAxis(unsigned int joystick, sf::Joystick::Axis axis, float threshold)
+{
+    Binding b;
+    b.kind = Kind::JoystickAxis;
+    b.joystick = joystick;
+    b.axis = axis;
+    b.threshold = threshold;
+    return b;
+}
+
+InputSystem::InputSystem(unsigned int player)
+{
+    setDefaultBindings(player, player != 0);
+}
+
+void InputSystem::setDefaultBindings(unsigned int player, bool sharedKeyboard)
+{
+    using Scan = sf::Keyboard::Scancode;
+    using Axis = sf::Joystick::Axis;
+
+    for (std::size_t a = 0; a < ActionCount; ++a)
+        clearBindings(static_cast<Action>(a));
+
+    // Scancodes follow the physical key position, so WASD stays WASD on any layout.
+    const bool wasd = player == 0;
+    const bool arrows = player == 1 || !sharedKeyboard;
+    if (wasd)
+    {
+        bind(Action::Left, Binding::key(Scan::A));
+        bind(Action::Right, Binding::key(Scan::D));
+        bind(Action::Up, Binding::key(Scan::W));
+        bind(Action::Down, Binding::key(Scan::S));
+        bind(Action::Jump, Binding::key(Scan::Space));
+        bind(Action::Run, Binding::key(Scan::LShift));
+        bind(Action::Pause, Binding::key(Scan::Escape));
+    }
+    if (arrows)
+    {
+        for (const auto& [action, code] : ArrowKeys)
+            bind(action, Binding::key(code));
+        if (!wasd)
+        {
+            bind(Action::Jump, Binding::key(Scan::RControl));
+            bind(Action::Run, Binding::key(Scan::RShift));
+            bind(Action::Pause, Binding::key(Scan::Enter));
+        }
+    }
+
+    const unsigned int joystick = player;
+    bind(Action::Left, Binding::joystickAxis(joystick, Axis::X, -50.f));
+    bind(Action::Left, Binding::joystickAxis(joystick, Axis::PovX, -50.f));
+    bind(Action::Right, Binding::joystickAxis(joystick, Axis::X, 50.f));
+    bind(Action::Right, Binding::joystickAxis(joystick, Axis::PovX, 50.f));
+    bind(Action::Up, Binding::joystickAxis(joystick, Axis::Y, -50.f));
+    bind(Action::Down, Binding::joystickAxis(joystick, Axis::Y, 50.f));
+    bind(Action::Jump, Binding::joystickButton(joystick, 0));
+    bind(Action::Run, Binding::joystickButton(joystick, 2));
+    bind(Action::Pause, Binding::joystickButton(joystick, 7));
+}
+
+void InputSystem::setKeyboardShared(bool shared)
+{
+    for (const auto& [action, code] : ArrowKeys)
+    {
+        for (Binding& b : m_bindings[static_cast<std::size_t>(action)])
+            if (b.kind == Binding::Kind::Key && b.scancode == code)
+                b = Binding{};
+        if (!shared)
+            bind(action, Binding::key(code));
+    }
+}
+
+void InputSystem::bind(Action action, const Binding& binding)
+{
+    auto& slots = m_bindings[static_cast<std::size_t>(action)];
+    auto free = std::find_if(slots.begin(), slots.end(),
+        [](const Binding& b) { return b.kind == Binding::Kind::None; });
+
+    if (free == slots.end())
+        free = slots.end() - 1;
+    *free = binding;
+}
+
+void InputSystem::rebind(Action action, const Binding& binding)
+{
+    clearBindings(action);
+    bind(action, binding);
+}
+
+void InputSystem::clearBindings(Action action)
+{
+    m_bindings[static_cast<std::size_t>(action)].fill(Binding{});
+}
+
+const std::array<Binding, InputSystem::MaxBindingsPerAction>& InputSystem::bindings(Action action) const
+{
+    return m_bindings[static_cast<std::size_t>(action)];
+}
+
+void InputSystem::handleEvent(const sf::Event& event)
+{
+    if (event.is<sf::Event::KeyPressed>() || event.is<sf::Event::KeyReleased>()
+        || event.is<sf::Event::JoystickButtonPressed>() || event.is<sf::Event::JoystickButtonReleased>())
+        noteInput(m_clock.getElapsedTime());
+}
+
+InputFrame InputSystem::sample(bool focused)
+{
+    std::uint16_t down = 0;
+    if (focused)
+    {
+        // Joystick state is otherwise only refreshed while events are pumped.
+        sf::Joystick::update();
+
+        for (std::size_t a = 0; a < ActionCount; ++a)
+            for (const Binding& b : m_bindings[a])
+                if (isActive(b))
+                {
+                    down |= InputFrame::bit(static_cast<Action>(a));
+                    break;
+                }
+    }
+
+    InputFrame frame;
+    frame.down = down;
+    frame.pressed = static_cast<std::uint16_t>(down & ~m_previousDown);
+    frame.released = static_cast<std::uint16_t>(~down & m_previousDown);
+    m_previousDown = down;
+
+    // Sampling can see a change before its event has been pumped (or without
+    // any event at all, e.g. analog sticks), so it starts the clock too.
+    if (frame.pressed || frame.released)
+        noteInput(m_clock.getElapsedTime());
+    if (m_pendingInput)
+        m_pendingSampled = true;
+
+    return frame;
+}
+
+void InputSystem::markPresented(Profiler& profiler)
+{
+    if (!m_pendingInput || !m_pendingSampled)
+        return;
+
+    m_lastLatency = m_clock.getElapsedTime() - *m_pendingInput;
+    m_pendingInput.reset();
+    m_pendingSampled = false;
+
+    if (!m_latencySeries)
+        m_latencySeries = profiler.track("input->present ms");
+    profiler.record(*m_latencySeries, m_lastLatency.asSeconds() * 1000.f);
+}
+
+bool InputSystem::isActive(const Binding& binding) const
+{
+    switch (binding.kind)
+    {
+    case Binding::Kind::Key:
+        return sf::Keyboard::isKeyPressed(binding.scancode);
+    case Binding::Kind::JoystickButton:
+        return sf::Joystick::isConnected(binding.joystick)
+            && sf::Joystick::isButtonPressed(binding.joystick, binding.button);
+    case Binding::Kind::JoystickAxis:
+    {
+        if (!sf::Joystick::isConnected(binding.joystick) || !sf::Joystick::hasAxis(binding.joystick, binding.axis))
+            return false;
+        const float position = sf::Joystick::getAxisPosition(binding.joystick, binding.axis);
+        return binding.threshold < 0.f ? position <= binding.threshold : position >= binding.threshold;
+    }
+    case Binding::Kind::None:
+        break;
+    }
+    return false;
+}
+
+void InputSystem::noteInput(sf::Time when)
+{
+    if (!m_pendingInput)
+        m_pendingInput = when;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "InputFrame.h"
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Joystick.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+class Profiler;
+
+// One physical source an action can be bound to.
+struct Binding
+{
+    enum class Kind : std::uint8_t { None, Key, JoystickButton, JoystickAxis };
+
+    Kind kind = Kind::None;
+    sf::Keyboard::Scancode scancode = sf::Keyboard::Scancode::Unknown;
+    unsigned int joystick = 0;
+    unsigned int button = 0;
+    sf::Joystick::Axis axis = sf::Joystick::Axis::X;
+    float threshold = 0.f;      // axis bindings: the sign picks the direction, in -100..100
+
+    static Binding key(sf::Keyboard::Scancode code);
+    static Binding joystickButton(unsigned int joystick, unsigned int button);
+    static Binding joystickAxis(unsigned int joystick, sf::Joystick::Axis axis, float threshold);
+};
+
+// Reads the real-time keyboard/joystick state instead of waiting for queued
+// events, so a press is seen by the very next tick that samples it.
+// It also measures how long it takes for a change in input to reach the screen.
+class InputSystem
+{
+public:
+    static constexpr std::size_t MaxBindingsPerAction = 4;
+
+    explicit InputSystem(unsigned int player = 0);
+
+    // Resets every action to the defaults for this player slot. When two
+    // players share the keyboard, player 0 keeps WASD and player 1 takes the
+    // arrows; alone, player 0 gets both. Player N uses joystick N.
+    void setDefaultBindings(unsigned int player, bool sharedKeyboard);
+    // Player 0 when a second player joins or leaves: hands the arrow keys
+    // over to player 1 or takes them back, leaving every other binding,
+    // rebinds included, as it is.
+    void setKeyboardShared(bool shared);
+
+    void bind(Action action, const Binding& binding);    // adds a binding, replacing the last one when full
+    void rebind(Action action, const Binding& binding);  // drops every binding of the action first
+    void clearBindings(Action action);
+    const std::array<Binding, MaxBindingsPerAction>& bindings(Action action) const;
+
+    // Feed every window event through here. Events only timestamp input for
+    // the latency measurement, the actual state comes from sample().
+    void handleEvent(const sf::Event& event);
+
+    // Call as late as possible, right before the simulation tick that consumes it.
+    // When the window has no focus every action reads as released.
+    InputFrame sample(bool focused);
+
+    // Call right after window.display(). Records input-to-present latency
+    // when this frame was the first to show a change in input.
+    void markPresented(Profiler& profiler);
+
+    sf::Time lastLatency() const { return m_lastLatency; }
+
+private:
+    bool isActive(const Binding& binding) const;
+    void noteInput(sf::Time when);
+
+    std::array<std::array<Binding, MaxBindingsPerAction>, ActionCount> m_bindings{};
+    std::uint16_t m_previousDown = 0;
+    sf::Clock m_clock;
+    std::optional<sf::Time> m_pendingInput;     // earliest input change that has not been presented yet
+    bool m_pendingSampled = false;              // ...and a tick has actually consumed it
+    sf::Time m_lastLatency;
+    std::optional<std::size_t> m_latencySeries;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Plain input data shared by the game, the simulation and the network code.
+// Deliberately free of SFML window types so headless builds can use it.
+
+// Logical actions the game reacts to. Gameplay only ever looks at these,
+// never at raw keys, so every action can be rebound.
+enum class Action : std::uint8_t
+{
+    Left,
+    Right,
+    Up,
+    Down,
+    Jump,
+    Run,
+    Pause,
+    Count
+};
+
+constexpr std::size_t ActionCount = static_cast<std::size_t>(Action::Count);
+
+// State of every action for one simulation tick, as bitmasks.
+struct InputFrame
+{
+    std::uint16_t down = 0;
+    std::uint16_t pressed = 0;      // went down since the previous sample
+    std::uint16_t released = 0;     // went up since the previous sample
+
+    bool isDown(Action action) const { return down & bit(action); }
+    bool wasPressed(Action action) const { return pressed & bit(action); }
+    bool wasReleased(Action action) const { return released & bit(action); }
+
+    // Rebuilds the edges from two consecutive held-button masks, for input
+    // that arrives as plain masks (network, replays, bots).
+    static InputFrame fromMasks(std::uint16_t down, std::uint16_t previousDown)
+    {
+        InputFrame frame;
+        frame.down = down;
+        frame.pressed = static_cast<std::uint16_t>(down & ~previousDown);
+        frame.released = static_cast<std::uint16_t>(~down & previousDown);
+        return frame;
+    }
+
+    // Inputs travel over the network as these masks, so they must stay bit-stable.
+    static std::uint16_t bit(Action action) { return static_cast<std::uint16_t>(1u << static_cast<unsigned>(action)); }
+};
@@ -0,0 +1,109 @@
+#include "JitterBuffer.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr double MaxDelaySeconds = 0.25;
+
+    // How many average-lateness units of headroom to keep; 2.5 covers nearly
+    // every packet on a connection whose jitter is roughly uniform.
+    constexpr double JitterHeadroom = 2.5;
+
+    // A late packet only nudges the clock offset up, so slow drift and route
+    // changes get followed without one slow packet shifting the whole timeline.
+    constexpr double OffsetDrift = 0.001;
+
+    // Limits how fast the delay may change. Remote time can then run at most
+    // 10% fast or slow, which is not noticeable, instead of jumping.
+    constexpr double DelaySlew = 0.1;
+
+    double seconds(sf::Time time)
+    {
+        return static_cast<double>(time.asMicroseconds()) / 1000000.0;
+    }
+}
+
+void JitterBuffer::push(const net::PlayerSnapshot& snapshot, sf::Time arrival)
+{
+    if (m_consumedTick && snapshot.tick < *m_consumedTick)
+    {
+        ++m_discarded;
+        return;
+    }
+
+    const auto at = std::lower_bound(m_snapshots.begin(), m_snapshots.end(), snapshot.tick,
+        [](const net::PlayerSnapshot& s, std::uint32_t tick) { return s.tick < tick; });
+    if (at != m_snapshots.end() && at->tick == snapshot.tick)
+    {
+        ++m_discarded;
+        return;
+    }
+    m_snapshots.insert(at, snapshot);
+    if (m_snapshots.size() > Capacity)
+        m_snapshots.pop_front();
+
+    // The fastest packet seen so far defines the base latency. How much later
+    // than that the others turn up is the jitter.
+    const double offset = seconds(arrival) - snapshot.tick * static_cast<double>(TickSeconds);
+    if (!m_offset || offset < *m_offset)
+        m_offset = offset;
+    else
+        *m_offset += (offset - *m_offset) * OffsetDrift;
+
+    m_jitter += (offset - *m_offset - m_jitter) / 16.0;
+}
+
+std::optional<JitterBuffer::Sample> JitterBuffer::sample(sf::Time now)
+{
+    if (m_snapshots.empty())
+        return std::nullopt;
+
+    // Always at least one tick behind, so there is usually a snapshot after
+    // the render time to interpolate towards.
+    const double target = std::clamp(TickSeconds + JitterHeadroom * m_jitter, static_cast<double>(TickSeconds), MaxDelaySeconds);
+    if (!m_lastSample)
+        m_delay = target;
+    else
+    {
+        const double maxChange = std::max(0.0, seconds(now - *m_lastSample)) * DelaySlew;
+        m_delay += std::clamp(target - m_delay, -maxChange, maxChange);
+    }
+    m_lastSample = now;
+
+    const double renderTick = (seconds(now) - *m_offset - m_delay) / TickSeconds;
+
+    while (m_snapshots.size() >= 2 && m_snapshots[1].tick <= renderTick)
+        m_snapshots.pop_front();
+    m_consumedTick = m_snapshots.front().tick;
+
+    const net::PlayerSnapshot& from = m_snapshots.front();
+    Sample sample;
+    sample.alive = from.alive;
+    sample.tick = renderTick;
+
+    if (renderTick <= from.tick)
+    {
+        // still waiting for time to reach the oldest snapshot
+        sample.position = from.position;
+    }
+    else if (m_snapshots.size() >= 2)
+    {
+        const net::PlayerSnapshot& to = m_snapshots[1];
+        const auto alpha = static_cast<float>((renderTick - from.tick) / (to.tick - from.tick));
+        sample.position = interpolate(from.position, to.position, alpha);
+    }
+    else
+    {
+        // Ran out of snapshots: keep going in a straight line briefly, then hold.
+        const auto ahead = static_cast<float>(std::min((renderTick - from.tick) * TickSeconds, static_cast<double>(MaxExtrapolationSeconds)));
+        sample.position = from.alive ? from.position + from.velocity * ahead : from.position;
+        sample.extrapolated = true;
+    }
+    return sample;
+}
+
+void JitterBuffer::clear()
+{
+    *this = JitterBuffer();
+}
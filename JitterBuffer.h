@@ -0,0 +1,57 @@
+#pragma once
+
+#include "NetProtocol.h"
+
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+// Smooths out one remote character whose snapshots arrive late, out of order
+// or not at all.
+//
+// Snapshots are kept sorted by server tick. The character is drawn a little
+// in the past, at a point where two received snapshots usually surround the
+// render time, and is interpolated between them. The delay adapts to the
+// measured arrival jitter: a steady connection draws close to live, a shaky
+// one buffers more. If packets stop arriving, the last snapshot is carried
+// forward by its velocity for a short while and then held.
+class JitterBuffer
+{
+public:
+    struct Sample
+    {
+        sf::Vector2f position;
+        bool alive = true;
+        bool extrapolated = false;
+        double tick = 0.0;          // server tick this sample represents, fractional
+    };
+
+    static constexpr std::size_t Capacity = 32;
+    static constexpr float MaxExtrapolationSeconds = 0.1f;
+
+    // arrival is local time, from any clock that keeps running.
+    void push(const net::PlayerSnapshot& snapshot, sf::Time arrival);
+
+    // Where to draw the character at local time now; empty until the first snapshot arrives.
+    std::optional<Sample> sample(sf::Time now);
+
+    void clear();
+
+    float delaySeconds() const { return static_cast<float>(m_delay); }
+    float jitterSeconds() const { return static_cast<float>(m_jitter); }
+
+    // packets that arrived too late to matter or repeated one already buffered
+    std::uint32_t discarded() const { return m_discarded; }
+
+private:
+    std::deque<net::PlayerSnapshot> m_snapshots;    // ascending tick
+    std::optional<std::uint32_t> m_consumedTick;    // everything before this has been drawn past
+    std::optional<double> m_offset;                 // local time minus server time, fastest path seen
+    double m_jitter = 0.0;
+    double m_delay = 0.0;
+    std::optional<sf::Time> m_lastSample;
+    std::uint32_t m_discarded = 0;
+};
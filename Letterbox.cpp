@@ -0,0 +1,37 @@
+#include "Letterbox.h"
+
+#include <algorithm>
+
+Letterbox::Letterbox(sf::Vector2f logicalSize) :
+    m_logicalSize(logicalSize),
+    m_view(sf::FloatRect({ 0.f, 0.f }, logicalSize))
+{
+}
+
+bool Letterbox::apply(sf::RenderWindow& window)
+{
+    if (!m_pendingSize)
+    {
+        // first frame: pick up the initial window size
+        if (m_revision != 0)
+            return false;
+        m_pendingSize = window.getSize();
+    }
+
+    const sf::Vector2u size = *m_pendingSize;
+    if (size.x == 0 || size.y == 0)
+        return false;       // minimized, keep the request until we get a real size
+    m_pendingSize.reset();
+
+    const sf::Vector2f windowSize(size);
+    m_scale = std::min(windowSize.x / m_logicalSize.x, windowSize.y / m_logicalSize.y);
+
+    const sf::Vector2f used = m_logicalSize * m_scale;
+    const sf::Vector2f offset = (windowSize - used) / 2.f;
+    m_view.setViewport(sf::FloatRect(offset.componentWiseDiv(windowSize), used.componentWiseDiv(windowSize)));
+    m_viewportPixels = sf::IntRect(sf::Vector2i(offset), sf::Vector2i(used));
+
+    window.setView(m_view);
+    ++m_revision;
+    return true;
+}
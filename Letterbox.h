@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <optional>
+
+// Maps the fixed logical play area onto whatever size the window has,
+// scaled uniformly with black bars on the sides that don't fit.
+//
+// Resize events only record the new size. Dragging a window edge fires
+// dozens of them per frame; the view is rebuilt once, in apply().
+class Letterbox
+{
+public:
+    explicit Letterbox(sf::Vector2f logicalSize);
+
+    void requestResize(sf::Vector2u windowSize) { m_pendingSize = windowSize; }
+
+    // Call once per frame after the event loop. Rebuilds and sets the view
+    // if a resize is pending; returns true when it did.
+    bool apply(sf::RenderWindow& window);
+
+    const sf::View& view() const { return m_view; }
+    sf::Vector2f logicalSize() const { return m_logicalSize; }
+    float scale() const { return m_scale; }                     // window pixels per logical unit
+    sf::IntRect viewportPixels() const { return m_viewportPixels; }
+
+    // Changes every time the transform is rebuilt, so targets sized from it
+    // can cheaply tell whether they need reallocating.
+    unsigned int revision() const { return m_revision; }
+
+private:
+    sf::Vector2f m_logicalSize;
+    std::optional<sf::Vector2u> m_pendingSize;
+    sf::View m_view;
+    float m_scale = 1.f;
+    sf::IntRect m_viewportPixels;
+    unsigned int m_revision = 0;
+};
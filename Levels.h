@@ -0,0 +1,28 @@
+#pragma once
+
+#include "TriggerIndex.h"
+#include "World.h"
+
+#include <array>
+
+// Level data, compiled into the game. Coordinates are world pixels on the
+// background as main.cpp lays it out: 1:1 horizontally, doubled vertically,
+// ground at y = 415.
+
+// World 1-1. The background's underground bonus room sits below the floor
+// line, where the simulation can't go, so the entry pipe warps straight to
+// the exit pipe.
+inline constexpr std::array<TriggerVolume, 3> Level1_1Triggers{ {
+    //  kind                      left     top     right    bottom   destination
+    { TriggerKind::Pipe,         911.f,  280.f,   941.f,  420.f,   { 2608.f, 371.f } },
+    { TriggerKind::Checkpoint,  1690.f,    0.f,  1700.f,  420.f,   {} },
+    { TriggerKind::Flagpole,    3166.f,   80.f,  3182.f,  420.f,   {} },
+} };
+
+// Extras over the original 1-1: a lift and a three-platform wheel along the
+// stretch before the staircases, both low enough to jump onto.
+inline constexpr std::array<PlatformLayout, 2> Level1_1Platforms{ {
+    //  pivot                swing           seconds  spin   radius  count  size
+    { { 1560.f, 360.f },   { 0.f, 40.f },    4.f,   0.f,    0.f,   1,   { 64.f, 16.f } },
+    { { 2000.f, 290.f },   { 0.f,  0.f },    0.f,   0.8f,  70.f,   3,   { 64.f, 16.f } },
+} };
@@ -0,0 +1,153 @@
+#include "LoopbackTest.h"
+#include "JitterBuffer.h"
+#include "NetProtocol.h"
+#include "Random.h"
+#include "World.h"
+
+#include <SFML/System/Time.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+namespace
+{
+    struct InFlight
+    {
+        double arrival;
+        net::PlayerSnapshot snapshot;
+    };
+
+    struct ErrorStats
+    {
+        std::vector<float> samples;
+
+        void add(float error) { samples.push_back(error); }
+
+        void print(const char* label)
+        {
+            if (samples.empty())
+                return;
+            std::sort(samples.begin(), samples.end());
+            double sum = 0.0;
+            for (float e : samples)
+                sum += e;
+            std::cout << "  " << std::left << std::setw(16) << label << std::right
+                      << " mean " << std::setw(6) << sum / samples.size()
+                      << "  p95 " << std::setw(6) << samples[samples.size() * 95 / 100]
+                      << "  max " << std::setw(6) << samples.back() << " px" << std::endl;
+        }
+    };
+
+    sf::Vector2f truthAt(const std::vector<sf::Vector2f>& history, double tick)
+    {
+        tick = std::clamp(tick, 0.0, static_cast<double>(history.size() - 1));
+        const auto index = static_cast<std::size_t>(tick);
+        if (index + 1 >= history.size())
+            return history.back();
+        return interpolate(history[index], history[index + 1], static_cast<float>(tick - index));
+    }
+
+    float distance(sf::Vector2f a, sf::Vector2f b)
+    {
+        return std::hypot(a.x - b.x, a.y - b.y);
+    }
+}
+
+int runLoopbackTest(const LoopbackConfig& config)
+{
+    // Same level as the battle server. The player walks, runs and jumps,
+    // turning round every few seconds so it stays inside the level.
+    World world({ 10.f, 371.f }, 3376.f);
+    const auto ticks = static_cast<std::uint32_t>(config.seconds * TickRate);
+
+    Random rng(config.seed);
+
+    std::vector<sf::Vector2f> history{ world.player().position };
+    std::vector<InFlight> packets;
+    std::uint16_t previousMask = 0;
+    std::uint32_t lost = 0;
+
+    for (std::uint32_t t = 0; t < ticks; ++t)
+    {
+        std::uint16_t mask = InputFrame::bit((t / (6 * TickRate)) % 2 == 0 ? Action::Right : Action::Left);
+        if (t % 50 < 12)
+            mask |= InputFrame::bit(Action::Jump);
+        if ((t / 150) % 2 == 0)
+            mask |= InputFrame::bit(Action::Run);
+
+        std::array<InputFrame, MaxPlayers> inputs{};
+        inputs[0] = InputFrame::fromMasks(mask, previousMask);
+        previousMask = mask;
+        world.step(inputs);
+        history.push_back(world.player().position);
+
+        if (rng.chance(config.lossPercent / 100.f))
+        {
+            ++lost;
+            continue;
+        }
+
+        net::PlayerSnapshot snapshot;
+        snapshot.tick = world.tick();
+        snapshot.position = world.player().position;
+        snapshot.velocity = world.player().velocity;
+        snapshot.alive = world.player().alive;
+        packets.push_back({ world.tick() * static_cast<double>(TickSeconds) + (config.latencyMs + rng.range(0.f, config.jitterMs)) / 1000.0, snapshot });
+    }
+
+    std::sort(packets.begin(), packets.end(), [](const InFlight& a, const InFlight& b) { return a.arrival < b.arrival; });
+
+    JitterBuffer buffer;
+    ErrorStats buffered;
+    ErrorStats newest;
+    ErrorStats reconstruction;
+    std::size_t next = 0;
+    std::uint32_t frames = 0;
+    std::uint32_t extrapolated = 0;
+    double delaySum = 0.0;
+    std::optional<net::PlayerSnapshot> latest;
+
+    const double frameSeconds = 1.0 / config.renderHz;
+    for (double now = 0.0; now < config.seconds; now += frameSeconds)
+    {
+        for (; next < packets.size() && packets[next].arrival <= now; ++next)
+        {
+            buffer.push(packets[next].snapshot, sf::microseconds(static_cast<std::int64_t>(packets[next].arrival * 1000000.0)));
+            if (!latest || packets[next].snapshot.tick > latest->tick)
+                latest = packets[next].snapshot;
+        }
+
+        const std::optional<JitterBuffer::Sample> sample = buffer.sample(sf::microseconds(static_cast<std::int64_t>(now * 1000000.0)));
+        if (!sample || !latest)
+            continue;
+
+        // Both are judged against the same moment: the freshest the link
+        // allows, "now minus the base latency". The delay the buffer adds on
+        // top counts against it. How closely it rebuilds the moment it
+        // actually shows is reported separately.
+        const sf::Vector2f live = truthAt(history, (now - config.latencyMs / 1000.0) / TickSeconds);
+        buffered.add(distance(sample->position, live));
+        newest.add(distance(latest->position, live));
+        reconstruction.add(distance(sample->position, truthAt(history, sample->tick)));
+
+        ++frames;
+        if (sample->extrapolated)
+            ++extrapolated;
+        delaySum += buffer.delaySeconds();
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Loopback: " << config.seconds << " s, latency " << config.latencyMs << " ms, jitter 0-" << config.jitterMs
+              << " ms, loss " << config.lossPercent << "% (" << lost << " of " << ticks << " lost), render " << config.renderHz << " Hz" << std::endl;
+    buffered.print("jitter buffer");
+    newest.print("newest packet");
+    reconstruction.print("buffer, own tick");
+    std::cout << "  buffer delay avg " << (frames ? delaySum / frames * 1000.0 : 0.0) << " ms (jitter estimate "
+              << buffer.jitterSeconds() * 1000.f << " ms), extrapolated " << (frames ? 100.0 * extrapolated / frames : 0.0)
+              << "% of frames, " << buffer.discarded() << " packets discarded" << std::endl;
+    return 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+struct LoopbackConfig
+{
+    float seconds = 30.f;           // simulated, the test runs as fast as it can
+    float latencyMs = 40.f;         // one-way base latency
+    float jitterMs = 30.f;          // extra delay, uniform in [0, jitterMs]
+    float lossPercent = 5.f;
+    float renderHz = 144.f;
+    std::uint32_t seed = 1;
+};
+
+// Runs a scripted player through a simulated link with jitter and loss into
+// a JitterBuffer, samples it at render rate and prints how far the drawn
+// position is from the true one, compared with drawing the newest packet.
+// Both are measured from where the player was one base latency ago, so the
+// delay the buffer adds counts as error too.
+// Returns 0 so it can sit in scripts.
+int runLoopbackTest(const LoopbackConfig& config);
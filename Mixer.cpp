@@ -0,0 +1,279 @@
+#include "Mixer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SUPERMARIO_MIXER_SSE2
+#endif
+
+namespace
+{
+    constexpr float SampleScale = 1.f / 32768.f;
+    constexpr float Ceiling = 0.98f;            // just under full scale
+    constexpr float ReleasePerSecond = 4.f;     // limiter gain recovers at most this much a second
+    constexpr float QuarterPi = 0.78539816f;
+
+    // Compilers vectorize plain loops like these only at some optimization
+    // levels, and never the max reduction or the clamp and narrowing store.
+    // So the SSE2 path (every x64 CPU, and MSVC's Win32 default) does four
+    // frames at a time, and the scalar loop finishes the rest.
+
+    // The buffers never overlap.
+    void accumulate(const std::int16_t* __restrict source, std::size_t count, float* __restrict left,
+                    float* __restrict right, float gainLeft, float gainRight)
+    {
+        std::size_t i = 0;
+#ifdef SUPERMARIO_MIXER_SSE2
+        const __m128 gainsLeft = _mm_set1_ps(gainLeft);
+        const __m128 gainsRight = _mm_set1_ps(gainRight);
+        for (; i + 4 <= count; i += 4)
+        {
+            // widen with sign: each int16 into the top half of an int32, then shift down
+            const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i));
+            const __m128 samples = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16));
+            _mm_storeu_ps(left + i, _mm_add_ps(_mm_loadu_ps(left + i), _mm_mul_ps(samples, gainsLeft)));
+            _mm_storeu_ps(right + i, _mm_add_ps(_mm_loadu_ps(right + i), _mm_mul_ps(samples, gainsRight)));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            const float sample = static_cast<float>(source[i]);
+            left[i] += sample * gainLeft;
+            right[i] += sample * gainRight;
+        }
+    }
+
+    float blockPeak(const float* left, const float* right, std::size_t frames)
+    {
+        std::size_t i = 0;
+        float peak = 0.f;
+#ifdef SUPERMARIO_MIXER_SSE2
+        const __m128 sign = _mm_set1_ps(-0.f);
+        __m128 peaks = _mm_setzero_ps();
+        for (; i + 4 <= frames; i += 4)
+        {
+            peaks = _mm_max_ps(peaks, _mm_andnot_ps(sign, _mm_loadu_ps(left + i)));
+            peaks = _mm_max_ps(peaks, _mm_andnot_ps(sign, _mm_loadu_ps(right + i)));
+        }
+        peaks = _mm_max_ps(peaks, _mm_movehl_ps(peaks, peaks));
+        peaks = _mm_max_ss(peaks, _mm_shuffle_ps(peaks, peaks, 1));
+        peak = _mm_cvtss_f32(peaks);
+#endif
+        for (; i < frames; ++i)
+            peak = std::max(peak, std::max(std::abs(left[i]), std::abs(right[i])));
+        return peak;
+    }
+
+    // Interleaves into out, the gain ramping linearly from start by step a frame.
+    void toPcm(const float* left, const float* right, std::int16_t* out, std::size_t frames,
+               float start, float step)
+    {
+        std::size_t i = 0;
+#ifdef SUPERMARIO_MIXER_SSE2
+        const __m128 low = _mm_set1_ps(-1.f);
+        const __m128 high = _mm_set1_ps(1.f);
+        const __m128 scale = _mm_set1_ps(32767.f);
+        const __m128 starts = _mm_set1_ps(start);
+        const __m128 steps = _mm_set1_ps(step);
+        const __m128 four = _mm_set1_ps(4.f);
+        __m128 index = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+        for (; i + 4 <= frames; i += 4, index = _mm_add_ps(index, four))
+        {
+            const __m128 gain = _mm_add_ps(starts, _mm_mul_ps(steps, index));
+            const __m128 l = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(left + i), gain), low), high);
+            const __m128 r = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(right + i), gain), low), high);
+            // truncates like static_cast; the clamp keeps the pack from saturating
+            const __m128i li = _mm_cvttps_epi32(_mm_mul_ps(l, scale));
+            const __m128i ri = _mm_cvttps_epi32(_mm_mul_ps(r, scale));
+            const __m128i pcm = _mm_packs_epi32(_mm_unpacklo_epi32(li, ri), _mm_unpackhi_epi32(li, ri));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), pcm);
+        }
+#endif
+        for (; i < frames; ++i)
+        {
+            const float gain = start + step * static_cast<float>(i);
+            out[2 * i] = static_cast<std::int16_t>(std::clamp(left[i] * gain, -1.f, 1.f) * 32767.f);
+            out[2 * i + 1] = static_cast<std::int16_t>(std::clamp(right[i] * gain, -1.f, 1.f) * 32767.f);
+        }
+    }
+}
+
+Mixer::Mixer(unsigned int sampleRate, std::size_t maxVoices) :
+    m_sampleRate(sampleRate),
+    m_maxVoices(maxVoices)
+{
+    m_active.reserve(maxVoices);
+}
+
+Mixer::SoundId Mixer::addSound(std::vector<std::int16_t> samples)
+{
+    m_sounds.push_back(std::move(samples));
+    return static_cast<SoundId>(m_sounds.size() - 1);
+}
+
+Mixer::VoiceId Mixer::play(SoundId sound, float volume, float pan, bool loop)
+{
+    const VoiceId voice = m_nextVoice++;
+    if (m_nextVoice == NoVoice)
+        ++m_nextVoice;
+    m_commands.push({ Command::Type::Play, loop, voice, sound, nullptr, volume, pan });
+    m_commands.publish();
+    return voice;
+}
+
+Mixer::VoiceId Mixer::play(MixerStream& stream, float volume, float pan, bool loop)
+{
+    const VoiceId voice = m_nextVoice++;
+    if (m_nextVoice == NoVoice)
+        ++m_nextVoice;
+    m_commands.push({ Command::Type::Play, loop, voice, 0, &stream, volume, pan });
+    m_commands.publish();
+    return voice;
+}
+
+void Mixer::stop(VoiceId voice)
+{
+    m_commands.push({ Command::Type::Stop, false, voice, 0, nullptr, 0.f, 0.f });
+    m_commands.publish();
+}
+
+void Mixer::setVolume(VoiceId voice, float volume, float pan)
+{
+    m_commands.push({ Command::Type::SetVolume, false, voice, 0, nullptr, volume, pan });
+    m_commands.publish();
+}
+
+void Mixer::gains(float volume, float pan, float& left, float& right)
+{
+    // constant power: a sound keeps its loudness as it moves across
+    const float angle = (std::clamp(pan, -1.f, 1.f) + 1.f) * QuarterPi;
+    left = volume * std::cos(angle) * SampleScale;
+    right = volume * std::sin(angle) * SampleScale;
+}
+
+void Mixer::apply(const Command& command)
+{
+    auto find = [this](VoiceId id)
+    {
+        return std::find_if(m_active.begin(), m_active.end(), [id](const Voice& v) { return v.id == id; });
+    };
+
+    switch (command.type)
+    {
+    case Command::Type::Play:
+    {
+        if (command.stream)
+        {
+            std::erase_if(m_active, [&command](const Voice& v) { return v.stream == command.stream; });
+            command.stream->rewind();
+        }
+        else if (command.sound >= m_sounds.size() || m_sounds[command.sound].empty())
+            return;
+        Voice voice{ command.voice, command.sound, command.stream, 0, 0.f, 0.f, command.loop };
+        gains(command.volume, command.pan, voice.left, voice.right);
+        if (m_active.size() < m_maxVoices)
+        {
+            m_active.push_back(voice);
+            return;
+        }
+        Voice* oldest = nullptr;
+        for (Voice& v : m_active)
+            if (!v.loop && (!oldest || v.cursor > oldest->cursor))
+                oldest = &v;
+        if (oldest)
+            *oldest = voice;
+        break;
+    }
+    case Command::Type::Stop:
+        if (auto it = find(command.voice); it != m_active.end())
+        {
+            *it = m_active.back();
+            m_active.pop_back();
+        }
+        break;
+    case Command::Type::SetVolume:
+        if (auto it = find(command.voice); it != m_active.end())
+            gains(command.volume, command.pan, it->left, it->right);
+        break;
+    }
+}
+
+bool Mixer::mixVoice(Voice& voice, float* left, float* right, std::size_t frames)
+{
+    if (voice.stream)
+        return mixStream(voice, left, right, frames);
+
+    const std::vector<std::int16_t>& samples = m_sounds[voice.sound];
+    std::size_t done = 0;
+    while (done < frames)
+    {
+        const std::size_t count = std::min(frames - done, samples.size() - voice.cursor);
+        accumulate(samples.data() + voice.cursor, count, left + done, right + done, voice.left, voice.right);
+        voice.cursor += count;
+        done += count;
+
+        if (voice.cursor == samples.size())
+        {
+            if (!voice.loop)
+                return false;
+            voice.cursor = 0;
+        }
+    }
+    return true;
+}
+
+bool Mixer::mixStream(Voice& voice, float* left, float* right, std::size_t frames)
+{
+    m_decoded.resize(frames);
+    std::size_t done = 0;
+    while (done < frames)
+    {
+        const std::size_t count = voice.stream->read(m_decoded.data(), frames - done);
+        accumulate(m_decoded.data(), count, left + done, right + done, voice.left, voice.right);
+        voice.cursor += count;
+        done += count;
+
+        if (done < frames)
+        {
+            if (!voice.loop || voice.cursor == 0)
+                return false;       // ended, or empty and would loop forever
+            voice.stream->rewind();
+            voice.cursor = 0;
+        }
+    }
+    return true;
+}
+
+void Mixer::mix(std::int16_t* out, std::size_t frames)
+{
+    m_commands.drain([this](const Command& command) { apply(command); });
+
+    m_left.assign(frames, 0.f);
+    m_right.assign(frames, 0.f);
+    for (std::size_t v = 0; v < m_active.size();)
+    {
+        if (mixVoice(m_active[v], m_left.data(), m_right.data(), frames))
+        {
+            ++v;
+            continue;
+        }
+        m_active[v] = m_active.back();
+        m_active.pop_back();
+    }
+
+    // Limiter: the gain drops at once to whatever keeps this block's peak
+    // under the ceiling, and ramps back up slowly once the peak has passed.
+    const float peak = blockPeak(m_left.data(), m_right.data(), frames);
+    const float target = peak > Ceiling ? Ceiling / peak : 1.f;
+    const float from = m_limiterGain;
+    const float to = target < from ? target
+        : std::min(target, from + ReleasePerSecond * static_cast<float>(frames) / static_cast<float>(m_sampleRate));
+    const float start = target < from ? to : from;
+    const float step = frames > 0 ? (to - start) / static_cast<float>(frames) : 0.f;
+    m_limiterGain = to;
+
+    toPcm(m_left.data(), m_right.data(), out, frames, start, step);
+}
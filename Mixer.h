@@ -0,0 +1,110 @@
+#pragma once
+
+#include "SpscQueue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A sound decoded as it plays, for clips too long to be worth keeping
+// decoded. Mono at the mixer's rate, like the bank. Only the mixing thread
+// calls these; a stream plays on one voice at a time.
+class MixerStream
+{
+public:
+    virtual ~MixerStream() = default;
+    virtual void rewind() = 0;
+    // Fills out with up to frames samples; fewer means the end was reached.
+    virtual std::size_t read(std::int16_t* out, std::size_t frames) = 0;
+};
+
+// Software mixer: every sound effect and music voice summed into one stereo
+// stream, so the game needs a single hardware source however many sounds
+// are playing. This is the mixing itself, with no audio device behind it;
+// AudioMixer plays the result through an sf::SoundStream, and the mixer
+// benchmark drives it directly.
+//
+// Sounds are mono 16-bit at the mixer's sample rate, added up front with
+// addSound(), or MixerStreams decoded on the mixing thread as they play. Voices are controlled from one thread (play, stop, setVolume)
+// while another calls mix(); the two only talk through a lock-free command
+// queue, so the audio thread never waits on the game.
+//
+// mix() converts each voice to float and accumulates it into separate left
+// and right buffers in plain loops the compiler vectorizes, then runs a
+// limiter over the sum so a pile of loud voices ducks instead of clipping.
+class Mixer
+{
+public:
+    using SoundId = std::uint32_t;
+    using VoiceId = std::uint32_t;
+    static constexpr VoiceId NoVoice = 0;
+
+    explicit Mixer(unsigned int sampleRate, std::size_t maxVoices = 64);
+
+    // Not once mixing has started: the audio thread reads the bank unlocked.
+    SoundId addSound(std::vector<std::int16_t> samples);
+    std::size_t soundCount() const { return m_sounds.size(); }
+    const std::vector<std::int16_t>& sound(SoundId id) const { return m_sounds[id]; }
+    unsigned int sampleRate() const { return m_sampleRate; }
+
+    // Control side, all from one thread. pan runs from -1 (left) to 1
+    // (right). If every voice is busy, play() takes over the one that has
+    // been playing longest, music excepted. Ids of voices that have
+    // finished are ignored.
+    VoiceId play(SoundId sound, float volume = 1.f, float pan = 0.f, bool loop = false);
+    // Starts stream from the beginning, taking it off any voice it was already on.
+    VoiceId play(MixerStream& stream, float volume = 1.f, float pan = 0.f, bool loop = false);
+    void stop(VoiceId voice);
+    void setVolume(VoiceId voice, float volume, float pan = 0.f);
+
+    // Mixing side: fills out with frames interleaved stereo frames.
+    void mix(std::int16_t* out, std::size_t frames);
+
+    // As of the last mix(); for the mixing thread, or once it has stopped.
+    std::size_t activeVoices() const { return m_active.size(); }
+    float limiterGain() const { return m_limiterGain; }
+
+private:
+    struct Command
+    {
+        enum class Type : std::uint8_t { Play, Stop, SetVolume };
+        Type type;
+        bool loop;
+        VoiceId voice;
+        SoundId sound;
+        MixerStream* stream;
+        float volume;
+        float pan;
+    };
+
+    struct Voice
+    {
+        VoiceId id;
+        SoundId sound;
+        MixerStream* stream;    // or null, playing sound from the bank
+        std::size_t cursor;     // next sample
+        float left;             // gains, with the int16 to float scale folded in
+        float right;
+        bool loop;
+    };
+
+    static void gains(float volume, float pan, float& left, float& right);
+    void apply(const Command& command);
+    bool mixVoice(Voice& voice, float* left, float* right, std::size_t frames);     // false once finished
+    bool mixStream(Voice& voice, float* left, float* right, std::size_t frames);
+
+    unsigned int m_sampleRate;
+    std::size_t m_maxVoices;
+    std::vector<std::vector<std::int16_t>> m_sounds;
+
+    // control thread
+    VoiceId m_nextVoice = NoVoice + 1;
+    SpscQueue<Command, 256> m_commands;
+
+    // mixing thread
+    std::vector<Voice> m_active;
+    std::vector<float> m_left;
+    std::vector<float> m_right;
+    std::vector<std::int16_t> m_decoded;    // a block of a stream
+    float m_limiterGain = 1.f;
+};
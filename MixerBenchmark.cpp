@@ -0,0 +1,102 @@
+#include "MixerBenchmark.h"
+#include "Mixer.h"
+#include "Random.h"
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    struct RunResult
+    {
+        sf::Time mixing = sf::microseconds(std::numeric_limits<std::int64_t>::max());
+        std::size_t minVoices = 0;
+        std::size_t clipped = 0;        // samples at full scale
+        float limiterGain = 1.f;
+    };
+
+    // A few seconds of square-ish tones, like the sound effects, in a handful of lengths.
+    std::vector<std::vector<std::int16_t>> makeSounds(unsigned int sampleRate, Random& random)
+    {
+        std::vector<std::vector<std::int16_t>> sounds;
+        for (int s = 0; s < 8; ++s)
+        {
+            const auto length = static_cast<std::size_t>(random.range(0.2f, 3.f) * static_cast<float>(sampleRate));
+            const float period = random.range(20.f, 200.f);
+            std::vector<std::int16_t> samples(length);
+            for (std::size_t i = 0; i < length; ++i)
+                samples[i] = std::fmod(static_cast<float>(i), period) < period / 2.f ? 12000 : -12000;
+            sounds.push_back(std::move(samples));
+        }
+        return sounds;
+    }
+
+    RunResult run(const MixerBenchmarkConfig& config)
+    {
+        RunResult result;
+        Random random(5, static_cast<std::uint64_t>(RandomStream::Particles));
+        Mixer mixer(config.sampleRate, config.voices);
+        for (std::vector<std::int16_t>& sound : makeSounds(config.sampleRate, random))
+            mixer.addSound(std::move(sound));
+
+        // looping, so the count never dips; the mixer applies them on the first block
+        for (std::size_t v = 0; v < config.voices; ++v)
+            mixer.play(random.below(static_cast<std::uint32_t>(mixer.soundCount())), random.range(0.3f, 1.f),
+                       random.range(-1.f, 1.f), true);
+
+        std::vector<std::int16_t> out(config.blockFrames * 2);
+        result.minVoices = config.voices;
+        sf::Clock clock;
+        for (std::size_t b = 0; b < config.blocks; ++b)
+        {
+            mixer.mix(out.data(), config.blockFrames);
+            result.minVoices = std::min(result.minVoices, mixer.activeVoices());
+        }
+        result.mixing = clock.getElapsedTime();
+        result.limiterGain = mixer.limiterGain();
+
+        // after the first few blocks the limiter has caught up; nothing may hit full scale
+        for (std::int16_t sample : out)
+            result.clipped += sample >= 32767 || sample <= -32767;
+        return result;
+    }
+}
+
+int runMixerBenchmark(const MixerBenchmarkConfig& config)
+{
+    if (config.voices == 0 || config.blocks == 0 || config.blockFrames == 0)
+        return 0;
+
+    RunResult best;
+    bool ok = true;
+    for (int r = 0; r < std::max(1, config.repeats); ++r)
+    {
+        const RunResult result = run(config);
+        ok = ok && result.minVoices == config.voices && result.clipped == 0;
+        if (result.mixing < best.mixing)
+            best = result;
+    }
+
+    const double blocks = static_cast<double>(config.blocks);
+    const double blockUs = best.mixing.asMicroseconds() / blocks;
+    const double budgetUs = 1e6 * static_cast<double>(config.blockFrames) / config.sampleRate;
+    const double voiceSamples = blocks * static_cast<double>(config.blockFrames * config.voices);
+    std::cout << std::fixed << std::setprecision(2)
+              << "Mixer: " << config.voices << " voices, " << config.blockFrames << "-frame blocks at "
+              << config.sampleRate << " Hz x " << config.blocks << " blocks, best of " << config.repeats << "\n"
+              << "  " << blockUs << " us/block, " << 100.0 * blockUs / budgetUs << "% of the block's "
+              << budgetUs / 1000.0 << " ms, " << best.mixing.asMicroseconds() * 1000.0 / voiceSamples
+              << " ns per voice sample\n"
+              << "  limiter gain " << best.limiterGain << ", " << best.minVoices << " voices at the least, "
+              << best.clipped << " clipped samples in the last block\n"
+              << "  " << (ok ? "every voice mixed without clipping" : "voices dropped or output clipped") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+struct MixerBenchmarkConfig
+{
+    std::size_t voices = 64;
+    unsigned int sampleRate = 22050;
+    std::size_t blockFrames = 512;
+    std::size_t blocks = 2000;
+    int repeats = 3;                // best run is reported
+};
+
+// Keeps the configured number of voices playing on a Mixer, with random
+// volumes and pans and loud enough together to keep the limiter working,
+// and mixes blocks the size AudioMixer asks for. Prints the cost per block,
+// as a share of the block's own playing time, and per voice sample. Returns
+// 1 if the mixer didn't keep every voice playing, or its output clipped.
+int runMixerBenchmark(const MixerBenchmarkConfig& config);
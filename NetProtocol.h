@@ -0,0 +1,75 @@
+#pragma once
+
+#include "World.h"
+
+#include <SFML/Network/Packet.hpp>
+#include <cstdint>
+
+// Datagrams between battle clients and the battle server. Every packet
+// starts with a MessageType byte. Everything is sent over sf::UdpSocket,
+// state is resent every tick, so a lost packet is simply superseded by the next one.
+namespace net
+{
+    constexpr unsigned short DefaultServerPort = 54000;
+
+    // Enemy positions beyond this many are left out of a state packet to keep
+    // it well under a typical MTU.
+    constexpr std::uint16_t MaxEnemiesPerState = 48;
+
+    enum class MessageType : std::uint8_t
+    {
+        Join,       // client -> server: (empty)
+        Input,      // client -> server: u32 tick, u16 held-actions mask
+        Leave,      // client -> server: (empty)
+        Welcome,    // server -> client: u16 world, u32 tick
+        Full,       // server -> client: (empty), every world is taken
+        State,      // server -> client: PlayerSnapshot + enemies
+        Hash,       // peer -> peer: StateHashes for one tick, see DesyncDetector
+    };
+
+    struct PlayerSnapshot
+    {
+        std::uint32_t tick = 0;
+        std::uint16_t world = 0;
+        sf::Vector2f position;
+        sf::Vector2f velocity;
+        bool alive = true;
+        std::uint16_t worldsLeft = 0;       // battle worlds whose player is still alive
+    };
+
+    inline sf::Packet& operator<<(sf::Packet& packet, MessageType type)
+    {
+        return packet << static_cast<std::uint8_t>(type);
+    }
+
+    inline sf::Packet& operator>>(sf::Packet& packet, MessageType& type)
+    {
+        std::uint8_t raw = 0;
+        packet >> raw;
+        type = static_cast<MessageType>(raw);
+        return packet;
+    }
+
+    inline sf::Packet& operator<<(sf::Packet& packet, const PlayerSnapshot& s)
+    {
+        return packet << s.tick << s.world << s.position.x << s.position.y
+                      << s.velocity.x << s.velocity.y << s.alive << s.worldsLeft;
+    }
+
+    inline sf::Packet& operator>>(sf::Packet& packet, PlayerSnapshot& s)
+    {
+        return packet >> s.tick >> s.world >> s.position.x >> s.position.y
+                      >> s.velocity.x >> s.velocity.y >> s.alive >> s.worldsLeft;
+    }
+}
+
+// StateHashes lives outside net, so its operators do too, where lookup finds them.
+inline sf::Packet& operator<<(sf::Packet& packet, const StateHashes& h)
+{
+    return packet << h.tick << h.players << h.enemies << h.projectiles << h.timers << h.random;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, StateHashes& h)
+{
+    return packet >> h.tick >> h.players >> h.enemies >> h.projectiles >> h.timers >> h.random;
+}
@@ -0,0 +1,411 @@
+#include "PagedBackground.h"
+#include "StateHash.h"
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Time.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    constexpr std::uint32_t PageFileMagic = 0x47504D53;     // "SMPG"
+    constexpr std::uint32_t PageFileVersion = 1;
+    constexpr std::size_t OsPageSize = 4096;
+    const sf::Time PollInterval = sf::milliseconds(2);
+
+    // Followed by the downscaled image, then the pages, left to right and
+    // top to bottom, from pagesOffset.
+    struct PageFileHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t pageSize;
+        std::uint32_t fallbackDivisor;
+        std::uint32_t fallbackWidth;
+        std::uint32_t fallbackHeight;
+        std::uint64_t sourceSize;
+        std::int64_t sourceTime;
+        std::uint64_t pagesOffset;
+    };
+
+    unsigned int divideRoundingUp(unsigned int value, unsigned int divisor)
+    {
+        return (value + divisor - 1) / divisor;
+    }
+
+    std::filesystem::path pageFilePath(const std::filesystem::path& directory, const std::filesystem::path& image)
+    {
+        StateHasher hasher;
+        for (const char c : image.generic_string())
+            hasher.add(static_cast<std::uint8_t>(c));
+        char name[24];
+        std::snprintf(name, sizeof name, "%016llx.pages", static_cast<unsigned long long>(hasher.finish()));
+        return directory / name;
+    }
+}
+
+PagedBackground::PagedBackground(sf::Vector2f position, sf::Vector2f scale) :
+    m_position(position),
+    m_scale(scale)
+{
+}
+
+PagedBackground::~PagedBackground()
+{
+    m_running = false;
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+bool PagedBackground::open(ThreadPool& pool, const std::filesystem::path& image,
+                           sf::Vector2f screenSize, std::size_t maxViews, const std::filesystem::path& directory)
+{
+    std::error_code error;
+    const std::uint64_t sourceSize = std::filesystem::file_size(image, error);
+    const std::int64_t sourceTime = error ? 0
+        : static_cast<std::int64_t>(std::filesystem::last_write_time(image, error).time_since_epoch().count());
+    if (error)
+    {
+        std::cerr << "Error: Failed to open " << image.string() << std::endl;
+        return false;
+    }
+    std::filesystem::create_directories(directory, error);
+
+    const std::filesystem::path pageFile = pageFilePath(directory, image);
+    PageFileHeader header{};
+    auto upToDate = [&]
+    {
+        if (m_file.size() < sizeof header)
+            return false;
+        std::memcpy(&header, m_file.data(), sizeof header);
+        const std::size_t pages = std::size_t{ divideRoundingUp(header.width, PageSize) } * divideRoundingUp(header.height, PageSize);
+        return header.magic == PageFileMagic && header.version == PageFileVersion && header.pageSize == PageSize
+            && header.sourceSize == sourceSize && header.sourceTime == sourceTime
+            && m_file.size() == header.pagesOffset + pages * PageBytes;
+    };
+    if (!m_file.open(pageFile) || !upToDate())
+    {
+        m_file.close();
+        if (!buildPageFile(pool, image, pageFile, sourceSize, sourceTime) || !m_file.open(pageFile) || !upToDate())
+        {
+            std::cerr << "Error: Failed to split " << image.string() << " into pages" << std::endl;
+            return false;
+        }
+    }
+
+    m_imageSize = { header.width, header.height };
+    m_pageGrid = { divideRoundingUp(header.width, PageSize), divideRoundingUp(header.height, PageSize) };
+    m_fallbackDivisor = header.fallbackDivisor;
+    m_pagesOffset = static_cast<std::size_t>(header.pagesOffset);
+    m_bounds = sf::FloatRect(m_position, sf::Vector2f(m_imageSize).componentWiseMul(m_scale));
+    m_pages.assign(std::size_t{ m_pageGrid.x } * m_pageGrid.y, Page{});
+
+    // Enough slots for every view's pages plus one either side, whether one
+    // view has the whole screen or maxViews share it.
+    const sf::Vector2f pageWorldSize = sf::Vector2f(PageSize, PageSize).componentWiseMul(m_scale);
+    auto pagesAround = [&](sf::Vector2f view)
+    {
+        const auto columns = std::min<std::size_t>(m_pageGrid.x, static_cast<std::size_t>(std::ceil(view.x / pageWorldSize.x)) + 3);
+        const auto rows = std::min<std::size_t>(m_pageGrid.y, static_cast<std::size_t>(std::ceil(view.y / pageWorldSize.y)) + 3);
+        return columns * rows;
+    };
+    const std::size_t views = std::max<std::size_t>(maxViews, 1);
+    const std::size_t slots = std::min(m_pages.size(),
+        std::max(pagesAround(screenSize), views * pagesAround({ screenSize.x / static_cast<float>(views), screenSize.y })));
+    m_slotsPerRow = std::max(1u, static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(slots)))));
+    const unsigned int slotRows = divideRoundingUp(static_cast<unsigned int>(slots), m_slotsPerRow);
+    m_slotPage.assign(slots, NoPage);
+
+    m_fallbackOrigin = { 0, slotRows * PageSize };
+    const sf::Vector2u fallbackSize(header.fallbackWidth, header.fallbackHeight);
+    if (!m_atlas.resize({ std::max(m_slotsPerRow * PageSize, fallbackSize.x), slotRows * PageSize + fallbackSize.y }))
+    {
+        std::cerr << "Error: Failed to create the background page cache" << std::endl;
+        return false;
+    }
+    m_atlas.update(m_file.data() + sizeof header, fallbackSize, m_fallbackOrigin);
+
+    m_running = true;
+    m_thread = std::thread(&PagedBackground::stream, this);
+    return true;
+}
+
+bool PagedBackground::buildPageFile(ThreadPool& pool, const std::filesystem::path& image,
+                                    const std::filesystem::path& pageFile, std::uint64_t sourceSize, std::int64_t sourceTime)
+{
+    // The decode is one stb_image call and can't be split, but everything
+    // after it can: the box filter by rows of the downscaled copy, and the
+    // pages a row of pages at a time, each thread taking some columns.
+    // Decoded straight into memory: the page file replaces the whole image,
+    // so an ImageCache entry for it would never be read.
+    sf::Image decoded;
+    if (!decoded.loadFromFile(image))
+        return false;
+    const unsigned int width = decoded.getSize().x;
+    const unsigned int height = decoded.getSize().y;
+    const std::uint8_t* pixels = decoded.getPixelsPtr();
+    if (width == 0 || height == 0)
+        return false;
+
+    // the downscaled copy: a plain box filter is plenty for a frame or two
+    const unsigned int divisor = std::max(8u, divideRoundingUp(width, FallbackMaxWidth));
+    const unsigned int fallbackWidth = divideRoundingUp(width, divisor);
+    const unsigned int fallbackHeight = divideRoundingUp(height, divisor);
+    std::vector<std::uint8_t> fallback(std::size_t{ fallbackWidth } * fallbackHeight * 4);
+    pool.parallelFor(fallbackHeight, [&](std::size_t begin, std::size_t end)
+    {
+        for (auto fy = static_cast<unsigned int>(begin); fy < end; ++fy)
+        {
+            for (unsigned int fx = 0; fx < fallbackWidth; ++fx)
+            {
+                unsigned int sum[4] = {};
+                unsigned int count = 0;
+                for (unsigned int y = fy * divisor; y < std::min(height, (fy + 1) * divisor); ++y)
+                {
+                    for (unsigned int x = fx * divisor; x < std::min(width, (fx + 1) * divisor); ++x)
+                    {
+                        const std::uint8_t* texel = pixels + (std::size_t{ y } * width + x) * 4;
+                        for (int c = 0; c < 4; ++c)
+                            sum[c] += texel[c];
+                        ++count;
+                    }
+                }
+                for (int c = 0; c < 4; ++c)
+                    fallback[(std::size_t{ fy } * fallbackWidth + fx) * 4 + c] = static_cast<std::uint8_t>(sum[c] / count);
+            }
+        }
+    });
+
+    // pages start on an OS page boundary, so faulting one in never drags in its neighbour
+    const std::size_t pagesOffset = (sizeof(PageFileHeader) + fallback.size() + OsPageSize - 1) / OsPageSize * OsPageSize;
+    const PageFileHeader header{ PageFileMagic, PageFileVersion, width, height, PageSize, divisor,
+                                 fallbackWidth, fallbackHeight, sourceSize, sourceTime, pagesOffset };
+
+    std::filesystem::path temporary = pageFile;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof header);
+        out.write(reinterpret_cast<const char*>(fallback.data()), static_cast<std::streamsize>(fallback.size()));
+        const std::vector<char> padding(pagesOffset - sizeof header - fallback.size(), 0);
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        // pages at the right and bottom edges are padded by repeating the last texel
+        const unsigned int columns = divideRoundingUp(width, PageSize);
+        std::vector<std::uint8_t> pageRow(std::size_t{ columns } * PageBytes);
+        for (unsigned int row = 0; row < divideRoundingUp(height, PageSize); ++row)
+        {
+            pool.parallelFor(columns, [&](std::size_t begin, std::size_t end)
+            {
+                for (auto column = static_cast<unsigned int>(begin); column < end; ++column)
+                {
+                    const unsigned int left = column * PageSize;
+                    const unsigned int used = std::min(PageSize, width - left);
+                    std::uint8_t* page = pageRow.data() + column * PageBytes;
+                    for (unsigned int y = 0; y < PageSize; ++y)
+                    {
+                        const std::uint8_t* source = pixels + (std::size_t{ std::min(row * PageSize + y, height - 1) } * width + left) * 4;
+                        std::uint8_t* destination = page + std::size_t{ y } * PageSize * 4;
+                        std::memcpy(destination, source, std::size_t{ used } * 4);
+                        for (unsigned int x = used; x < PageSize; ++x)
+                            std::memcpy(destination + x * 4, source + (used - 1) * 4, 4);
+                    }
+                }
+            });
+            out.write(reinterpret_cast<const char*>(pageRow.data()), static_cast<std::streamsize>(pageRow.size()));
+        }
+        if (!out)
+            return false;
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, pageFile, error);
+    if (error)
+    {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+sf::Vector2u PagedBackground::slotOrigin(std::uint32_t slot) const
+{
+    return { slot % m_slotsPerRow * PageSize, slot / m_slotsPerRow * PageSize };
+}
+
+void PagedBackground::load(const sf::FloatRect& area)
+{
+    const sf::Vector2f left = (area.position - m_position).componentWiseDiv(m_scale);
+    const sf::Vector2f right = left + area.size.componentWiseDiv(m_scale);
+    for (unsigned int row = 0; row < m_pageGrid.y; ++row)
+    {
+        for (unsigned int column = 0; column < m_pageGrid.x; ++column)
+        {
+            const sf::Vector2f cell(static_cast<float>(column * PageSize), static_cast<float>(row * PageSize));
+            if (cell.x >= right.x || cell.x + PageSize <= left.x || cell.y >= right.y || cell.y + PageSize <= left.y)
+                continue;
+            const std::uint32_t index = row * m_pageGrid.x + column;
+            m_pages[index].lastSeen = m_frame;
+            if (m_pages[index].state == PageState::Absent)
+                upload(index);
+        }
+    }
+}
+
+void PagedBackground::appendVisible(const sf::FloatRect& area, std::vector<sf::Vertex>& out)
+{
+    if (m_pages.empty())
+        return;
+
+    // visible cells, in texel space
+    const sf::Vector2f left = (area.position - m_position).componentWiseDiv(m_scale);
+    const sf::Vector2f right = left + area.size.componentWiseDiv(m_scale);
+    if (right.x <= 0.f || right.y <= 0.f || left.x >= static_cast<float>(m_imageSize.x) || left.y >= static_cast<float>(m_imageSize.y))
+        return;
+    auto cellOf = [](float texel, unsigned int count)
+    {
+        return std::min(static_cast<int>(count) - 1, std::max(0, static_cast<int>(std::floor(texel / PageSize))));
+    };
+    const int firstColumn = cellOf(left.x, m_pageGrid.x);
+    const int lastColumn = cellOf(std::nextafter(right.x, 0.f), m_pageGrid.x);
+    const int firstRow = cellOf(left.y, m_pageGrid.y);
+    const int lastRow = cellOf(std::nextafter(right.y, 0.f), m_pageGrid.y);
+
+    for (int row = std::max(0, firstRow - 1); row <= std::min(static_cast<int>(m_pageGrid.y) - 1, lastRow + 1); ++row)
+    {
+        for (int column = std::max(0, firstColumn - 1); column <= std::min(static_cast<int>(m_pageGrid.x) - 1, lastColumn + 1); ++column)
+        {
+            const auto index = static_cast<std::uint32_t>(row) * m_pageGrid.x + static_cast<std::uint32_t>(column);
+            Page& page = m_pages[index];
+            page.lastSeen = m_frame;
+            if (page.state == PageState::Absent && m_inFlight < QueueCapacity && m_requests.push(index))
+            {
+                page.state = PageState::Requested;
+                ++m_inFlight;
+            }
+            if (column < firstColumn || column > lastColumn || row < firstRow || row > lastRow)
+                continue;   // just asked for ahead of time
+
+            // corners straight from texel coordinates, so neighbouring cells share their edges exactly
+            const sf::Vector2u texelTopLeft(static_cast<unsigned int>(column) * PageSize, static_cast<unsigned int>(row) * PageSize);
+            const sf::Vector2u texelBottomRight(std::min(texelTopLeft.x + PageSize, m_imageSize.x),
+                                                std::min(texelTopLeft.y + PageSize, m_imageSize.y));
+            const sf::Vector2f tl = m_position + sf::Vector2f(texelTopLeft).componentWiseMul(m_scale);
+            const sf::Vector2f br = m_position + sf::Vector2f(texelBottomRight).componentWiseMul(m_scale);
+
+            sf::Vector2f ttl;
+            sf::Vector2f tbr;
+            if (page.state == PageState::Resident)
+            {
+                ttl = sf::Vector2f(slotOrigin(page.slot));
+                tbr = ttl + sf::Vector2f(texelBottomRight - texelTopLeft);
+            }
+            else
+            {
+                const float divisor = static_cast<float>(m_fallbackDivisor);
+                ttl = sf::Vector2f(m_fallbackOrigin) + sf::Vector2f(texelTopLeft) / divisor;
+                tbr = sf::Vector2f(m_fallbackOrigin) + sf::Vector2f(texelBottomRight) / divisor;
+                ++m_waiting;
+            }
+
+            out.push_back({ tl, sf::Color::White, ttl });
+            out.push_back({ { br.x, tl.y }, sf::Color::White, { tbr.x, ttl.y } });
+            out.push_back({ { tl.x, br.y }, sf::Color::White, { ttl.x, tbr.y } });
+            out.push_back({ { tl.x, br.y }, sf::Color::White, { ttl.x, tbr.y } });
+            out.push_back({ { br.x, tl.y }, sf::Color::White, { tbr.x, ttl.y } });
+            out.push_back({ br, sf::Color::White, tbr });
+        }
+    }
+    m_requests.publish();
+}
+
+void PagedBackground::update(std::size_t maxBytes)
+{
+    m_ready.drain([this](std::uint32_t page)
+    {
+        --m_inFlight;
+        m_pages[page].state = PageState::Arrived;
+        m_arrived.push_back(page);
+    });
+
+    // m_frame is still the frame the views were just built for
+    std::size_t sent = 0;
+    std::size_t kept = 0;
+    for (const std::uint32_t page : m_arrived)
+    {
+        if (m_pages[page].lastSeen < m_frame)
+        {
+            m_pages[page].state = PageState::Absent;    // the camera has moved on
+            continue;
+        }
+        if (sent < maxBytes && upload(page))
+        {
+            sent += PageBytes;
+            continue;
+        }
+        m_arrived[kept++] = page;
+    }
+    m_arrived.resize(kept);
+
+    ++m_frame;
+    m_waiting = 0;
+}
+
+bool PagedBackground::upload(std::uint32_t page)
+{
+    // a free slot, or else the page seen least recently, as long as that wasn't this frame
+    std::uint32_t slot = NoPage;
+    std::uint64_t oldest = m_frame;
+    for (std::uint32_t s = 0; s < m_slotPage.size(); ++s)
+    {
+        if (m_slotPage[s] == NoPage)
+        {
+            slot = s;
+            break;
+        }
+        if (m_pages[m_slotPage[s]].lastSeen < oldest)
+        {
+            oldest = m_pages[m_slotPage[s]].lastSeen;
+            slot = s;
+        }
+    }
+    if (slot == NoPage)
+        return false;
+
+    if (m_slotPage[slot] != NoPage)
+    {
+        m_pages[m_slotPage[slot]].state = PageState::Absent;
+        --m_resident;
+    }
+    m_atlas.update(pagePixels(page), { PageSize, PageSize }, slotOrigin(slot));
+    m_slotPage[slot] = page;
+    m_pages[page].state = PageState::Resident;
+    m_pages[page].slot = slot;
+    ++m_resident;
+    return true;
+}
+
+void PagedBackground::stream()
+{
+    while (m_running)
+    {
+        m_requests.drain([this](std::uint32_t page)
+        {
+            // Touch every OS page of it, so any disk read happens here and
+            // not in the middle of the render thread's upload.
+            const volatile std::uint8_t* bytes = pagePixels(page);
+            for (std::size_t i = 0; i < PageBytes; i += OsPageSize)
+                static_cast<void>(bytes[i]);
+            m_ready.push(page);
+        });
+        m_ready.publish();
+        sf::sleep(PollInterval);
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "SpscQueue.h"
+#include "ThreadPool.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+// A background too wide to keep on the GPU whole, drawn from fixed-size
+// pages. The image is split once into a page file under cache/pages, each
+// page stored contiguously, plus a small downscaled copy of the whole image.
+// Only the pages around the cameras are resident, in slots of one atlas
+// texture sized from the screen area rather than the image, so VRAM stays
+// the same however long the level gets.
+//
+// Views ask for the pages they can see, and one page either side, as they
+// are built. A streaming thread faults each requested page of the mapped
+// page file in from disk and hands it back; update() then uploads it
+// straight from the mapping into the slot of the page seen least recently.
+// Until a page arrives its cell is drawn from the downscaled copy, which
+// lives in the atlas too, so the background never has holes whatever the
+// scroll speed, it is only blurry for a frame or two. Everything draws with
+// one texture in one call.
+class PagedBackground
+{
+public:
+    static constexpr unsigned int PageSize = 256;       // texels, square
+    static constexpr unsigned int FallbackMaxWidth = 1024;  // texels; the downscale is at least 8:1
+
+    PagedBackground(sf::Vector2f position, sf::Vector2f scale);
+    ~PagedBackground();
+
+    PagedBackground(const PagedBackground&) = delete;
+    PagedBackground& operator=(const PagedBackground&) = delete;
+
+    // Maps the page file for image, splitting it first if there is none or
+    // the image has changed since, and makes room for maxViews views sharing
+    // a screen of screenSize world units. A split is spread over pool. The
+    // page file is the only copy kept; no ImageCache entry is written.
+    bool open(ThreadPool& pool, const std::filesystem::path& image, sf::Vector2f screenSize,
+              std::size_t maxViews, const std::filesystem::path& directory = "cache/pages");
+
+    sf::Vector2u imageSize() const { return m_imageSize; }
+    sf::FloatRect bounds() const { return m_bounds; }
+    const sf::Texture& texture() const { return m_atlas; }
+
+    // Makes the pages under area resident right away, for the first frame.
+    void load(const sf::FloatRect& area);
+
+    // Appends two triangles per page overlapping area, from the page if it
+    // is resident and the downscaled copy if not, and requests whatever
+    // isn't resident within a page of it. From the render thread.
+    void appendVisible(const sf::FloatRect& area, std::vector<sf::Vertex>& out);
+
+    // Once per frame, before the views: uploads pages that have arrived, up
+    // to maxBytes, and drops the ones no view has wanted since they were asked for.
+    void update(std::size_t maxBytes);
+
+    std::size_t slotCount() const { return m_slotPage.size(); }
+    std::size_t residentPages() const { return m_resident; }
+    std::size_t pageCount() const { return m_pages.size(); }
+    // cells drawn from the downscaled copy since the last update()
+    std::size_t waitingCells() const { return m_waiting; }
+
+private:
+    static constexpr std::size_t PageBytes = std::size_t{ PageSize } * PageSize * 4;
+    static constexpr std::size_t QueueCapacity = 64;        // pages in flight
+    static constexpr std::uint32_t NoPage = 0xFFFFFFFF;
+
+    enum class PageState : std::uint8_t { Absent, Requested, Arrived, Resident };
+
+    struct Page
+    {
+        PageState state = PageState::Absent;
+        std::uint32_t slot = 0;
+        std::uint64_t lastSeen = 0;     // update() count when a view last wanted it
+    };
+
+    bool buildPageFile(ThreadPool& pool, const std::filesystem::path& image,
+                       const std::filesystem::path& pageFile, std::uint64_t sourceSize, std::int64_t sourceTime);
+    const std::uint8_t* pagePixels(std::size_t page) const { return m_file.data() + m_pagesOffset + page * PageBytes; }
+    sf::Vector2u slotOrigin(std::uint32_t slot) const;
+    bool upload(std::uint32_t page);     // false if every slot is in use this frame
+    void stream();
+
+    sf::Vector2f m_position;
+    sf::Vector2f m_scale;
+    sf::FloatRect m_bounds;
+    sf::Vector2u m_imageSize;
+    sf::Vector2u m_pageGrid;            // columns, rows
+    unsigned int m_fallbackDivisor = 1;
+    sf::Vector2u m_fallbackOrigin;      // in the atlas, below the slots
+    unsigned int m_slotsPerRow = 1;
+
+    MappedFile m_file;
+    std::size_t m_pagesOffset = 0;
+    sf::Texture m_atlas;                // never smoothed, so slots don't bleed into each other
+    std::vector<Page> m_pages;
+    std::vector<std::uint32_t> m_slotPage;     // resident page per slot, or NoPage
+    std::vector<std::uint32_t> m_arrived;      // streamed in, waiting for a slot
+    std::uint64_t m_frame = 1;
+    std::size_t m_resident = 0;
+    std::size_t m_inFlight = 0;
+    std::size_t m_waiting = 0;
+
+    // requests go to the streaming thread, pages ready to upload come back
+    SpscQueue<std::uint32_t, QueueCapacity> m_requests;
+    SpscQueue<std::uint32_t, QueueCapacity> m_ready;
+    std::atomic<bool> m_running{ false };
+    std::thread m_thread;
+};
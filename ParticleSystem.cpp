@@ -0,0 +1,70 @@
+#include "ParticleSystem.h"
+
+#include <array>
+#include <cmath>
+
+namespace
+{
+    struct Burst
+    {
+        int count;              // at full density
+        float speed;            // pixels per second, outwards
+        float life;             // seconds
+        sf::Color color;
+    };
+
+    // By GameEventKind; a count of 0 has no burst.
+    constexpr std::array<Burst, GameEventKindCount> Bursts{ {
+        //  count  speed   life   color
+        {   0,     0.f,   0.f,   sf::Color::White },             // Jump
+        {   6,   140.f,   0.35f, sf::Color(200, 76, 12) },       // Stomp
+        {   8,   220.f,   0.4f,  sf::Color(255, 255, 255) },     // Kick
+        {  12,   160.f,   0.6f,  sf::Color(255, 220, 60) },      // PowerUp
+        {   0,     0.f,   0.f,   sf::Color::White },             // Fireball
+        {   0,     0.f,   0.f,   sf::Color::White },             // Pipe
+        {  16,   260.f,   0.8f,  sf::Color(60, 200, 60) },       // Flagpole
+        {   0,     0.f,   0.f,   sf::Color::White },             // HurryUp
+        {   0,     0.f,   0.f,   sf::Color::White },             // PlayerDied
+    } };
+
+    constexpr float Gravity = 900.f;
+    constexpr float TwoPi = 6.2831853f;
+}
+
+ParticleSystem::ParticleSystem(std::size_t capacity) :
+    m_capacity(capacity),
+    m_random(0, static_cast<std::uint64_t>(RandomStream::Particles))
+{
+    m_particles.reserve(capacity);
+}
+
+void ParticleSystem::spawn(const GameEvent& event, float density)
+{
+    const Burst& burst = Bursts[static_cast<std::size_t>(event.kind)];
+    const auto count = static_cast<std::size_t>(std::lround(static_cast<float>(burst.count) * density));
+    for (std::size_t i = 0; i < count && m_particles.size() < m_capacity; ++i)
+    {
+        const float angle = m_random.range(0.f, TwoPi);
+        const float speed = burst.speed * m_random.range(0.5f, 1.f);
+        m_particles.push_back({ event.position, { std::cos(angle) * speed, std::sin(angle) * speed - burst.speed },
+                                burst.life * m_random.range(0.7f, 1.f), burst.color });
+    }
+}
+
+void ParticleSystem::update(float dt)
+{
+    for (std::size_t i = 0; i < m_particles.size();)
+    {
+        Particle& particle = m_particles[i];
+        particle.life -= dt;
+        if (particle.life <= 0.f)
+        {
+            particle = m_particles.back();
+            m_particles.pop_back();
+            continue;
+        }
+        particle.velocity.y += Gravity * dt;
+        particle.position += particle.velocity * dt;
+        ++i;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Random.h"
+#include "World.h"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+// Short-lived debris and sparkles for gameplay events, fed from the event
+// bus's effects channel. Purely cosmetic: it runs on frame time, rolls its
+// own random numbers, and nothing in the World ever reads it back, so it
+// can be thinned out or skipped without touching gameplay.
+class ParticleSystem
+{
+public:
+    struct Particle
+    {
+        sf::Vector2f position;
+        sf::Vector2f velocity;
+        float life;             // seconds left
+        sf::Color color;
+    };
+
+    explicit ParticleSystem(std::size_t capacity = 512);
+
+    // Spawns event's burst, if it has one. density is the fraction of the
+    // full burst to spawn (QualitySettings::particleDensity).
+    void spawn(const GameEvent& event, float density);
+    void update(float dt);
+
+    const std::vector<Particle>& particles() const { return m_particles; }
+
+private:
+    std::size_t m_capacity;
+    std::vector<Particle> m_particles;
+    Random m_random;
+};
@@ -0,0 +1,65 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <utility>
+
+float Profiler::Series::last() const
+{
+    if (count == 0)
+        return 0.f;
+    return samples[(head + HistorySize - 1) % HistorySize];
+}
+
+float Profiler::Series::average() const
+{
+    if (count == 0)
+        return 0.f;
+
+    float sum = 0.f;
+    for (std::size_t i = 0; i < count; ++i)
+        sum += samples[i];
+    return sum / static_cast<float>(count);
+}
+
+float Profiler::Series::max() const
+{
+    if (count == 0)
+        return 0.f;
+    return *std::max_element(samples.begin(), samples.begin() + count);
+}
+
+std::size_t Profiler::track(const std::string& name)
+{
+    for (std::size_t i = 0; i < m_series.size(); ++i)
+        if (m_series[i].name == name)
+            return i;
+
+    m_series.push_back(Series{ name });
+    return m_series.size() - 1;
+}
+
+void Profiler::record(std::size_t series, float value)
+{
+    Series& s = m_series[series];
+    s.samples[s.head] = value;
+    s.head = (s.head + 1) % HistorySize;
+    s.count = std::min(s.count + 1, HistorySize);
+}
+
+void Profiler::note(std::string message)
+{
+    if (m_notes.size() == MaxNotes)
+        m_notes.pop_front();
+    m_notes.push_back(std::move(message));
+}
+
+void Profiler::report(std::ostream& out) const
+{
+    out << std::fixed << std::setprecision(2);
+    for (const Series& s : m_series)
+        out << std::left << std::setw(24) << s.name
+            << " last " << s.last() << "  avg " << s.average() << "  max " << s.max() << '\n';
+    for (const std::string& n : m_notes)
+        out << "  " << n << '\n';
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Keeps a short rolling history of named per-frame measurements
+// (milliseconds, counts, ...) for the debug overlay and console reports.
+// Look a series up once with track() and record through the returned index,
+// so the per-frame path never touches strings.
+class Profiler
+{
+public:
+    static constexpr std::size_t HistorySize = 120;
+
+    struct Series
+    {
+        std::string name;
+        std::array<float, HistorySize> samples{};
+        std::size_t count = 0;      // number of valid samples, up to HistorySize
+        std::size_t head = 0;       // slot the next sample goes into
+
+        float last() const;
+        float average() const;
+        float max() const;
+    };
+
+    // Returns the index of the series with this name, creating it if needed.
+    std::size_t track(const std::string& name);
+
+    void record(std::size_t series, float value);
+
+    // One-off notes (quality changes, hitches, ...). Only the latest few are kept.
+    void note(std::string message);
+
+    const std::vector<Series>& series() const { return m_series; }
+    const std::deque<std::string>& notes() const { return m_notes; }
+
+    void report(std::ostream& out) const;
+
+private:
+    static constexpr std::size_t MaxNotes = 6;
+
+    std::vector<Series> m_series;
+    std::deque<std::string> m_notes;
+};
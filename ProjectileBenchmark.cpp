@@ -0,0 +1,124 @@
+#include "ProjectileBenchmark.h"
+#include "ProjectilePool.h"
+#include "Random.h"
+#include "TileGrid.h"
+#include "World.h"
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t Columns = 2048;
+    constexpr std::size_t Rows = 16;
+    constexpr std::size_t FloorRow = 12;
+    constexpr std::size_t PillarSpacing = 24;       // columns between three-tile pillars
+    constexpr float DespawnFraction = 0.01f;        // of the pool, by handle, every tick
+
+    struct RunResult
+    {
+        sf::Time update;
+        sf::Time spawn;
+        sf::Time despawn;
+        std::size_t spawns = 0;
+        std::size_t despawns = 0;
+        std::size_t staleHandles = 0;
+        bool stable = true;         // no drops, no reallocation
+    };
+
+    TileGrid makeLevel()
+    {
+        TileGrid tiles({ 0.f, 0.f }, Columns, Rows, TileSize);
+        tiles.fillFrom(FloorRow);
+        for (std::size_t c = PillarSpacing; c < Columns; c += PillarSpacing)
+            for (std::size_t r = FloorRow - 3; r < FloorRow; ++r)
+                tiles.setSolid(c, r);
+        return tiles;
+    }
+
+    ProjectileHandle spawnOne(ProjectilePool& pool, Random& random)
+    {
+        const auto kind = static_cast<ProjectileKind>(random.below(static_cast<std::uint32_t>(ProjectileKindCount)));
+        const sf::Vector2f position(random.range(0.f, Columns * TileSize), random.range(0.f, (FloorRow - 1) * TileSize));
+        const sf::Vector2f velocity(random.range(-300.f, 300.f), random.range(-400.f, 100.f));
+        // the benchmark only spawns into free room, so this always succeeds
+        return pool.spawn(kind, position, velocity).value_or(ProjectileHandle{});
+    }
+
+    RunResult run(const ProjectileBenchmarkConfig& config, const TileGrid& tiles)
+    {
+        RunResult result;
+        ProjectilePool pool(config.projectiles);
+        Random random(7, static_cast<std::uint64_t>(RandomStream::Particles));
+        std::vector<ProjectileHandle> handles(config.projectiles);   // most recent spawns, round robin
+        std::size_t nextHandle = 0;
+
+        for (std::size_t i = 0; i < config.projectiles; ++i)
+            handles[i] = spawnOne(pool, random);
+        const float* storage = pool.x();
+        const auto despawnsPerTick = static_cast<std::size_t>(static_cast<float>(config.projectiles) * DespawnFraction);
+
+        sf::Clock clock;
+        for (std::uint32_t t = 0; t < config.ticks; ++t)
+        {
+            clock.restart();
+            pool.update(TickSeconds, tiles);
+            result.update += clock.getElapsedTime();
+
+            clock.restart();
+            for (std::size_t i = 0; i < despawnsPerTick; ++i)
+            {
+                if (pool.despawn(handles[random.below(static_cast<std::uint32_t>(handles.size()))]))
+                    ++result.despawns;
+                else
+                    ++result.staleHandles;
+            }
+            result.despawn += clock.getElapsedTime();
+
+            clock.restart();
+            while (pool.size() < config.projectiles)
+            {
+                handles[nextHandle] = spawnOne(pool, random);
+                nextHandle = (nextHandle + 1) % handles.size();
+                ++result.spawns;
+            }
+            result.spawn += clock.getElapsedTime();
+        }
+
+        result.stable = pool.dropped() == 0 && pool.x() == storage && pool.capacity() == config.projectiles;
+        return result;
+    }
+}
+
+int runProjectileBenchmark(const ProjectileBenchmarkConfig& config)
+{
+    const TileGrid tiles = makeLevel();
+    RunResult best;
+    best.update = sf::microseconds(std::numeric_limits<std::int64_t>::max());
+    bool stable = true;
+
+    for (int r = 0; r < std::max(1, config.repeats); ++r)
+    {
+        const RunResult result = run(config, tiles);
+        stable = stable && result.stable;
+        if (result.update < best.update)
+            best = result;
+    }
+
+    const double projectileTicks = static_cast<double>(config.projectiles) * config.ticks;
+    const double handleOps = static_cast<double>(std::max<std::size_t>(1, best.despawns + best.staleHandles));
+    std::cout << std::fixed << std::setprecision(1)
+              << "Projectiles: " << config.projectiles << " live x " << config.ticks << " ticks, best of " << config.repeats << "\n"
+              << "  update + tile collision " << best.update.asMicroseconds() * 1000.0 / projectileTicks << " ns/projectile/tick\n"
+              << "  spawn " << best.spawn.asMicroseconds() * 1000.0 / static_cast<double>(std::max<std::size_t>(1, best.spawns))
+              << " ns (" << best.spawns << " spawns)\n"
+              << "  despawn " << best.despawn.asMicroseconds() * 1000.0 / handleOps << " ns (" << best.despawns
+              << " by handle, " << best.staleHandles << " stale handles ignored)\n"
+              << "  " << (stable ? "no spawn dropped, storage never reallocated" : "the pool dropped spawns or reallocated") << std::endl;
+    return stable ? 0 : 1;
+}
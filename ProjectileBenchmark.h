@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct ProjectileBenchmarkConfig
+{
+    std::size_t projectiles = 50000;
+    std::uint32_t ticks = 600;
+    int repeats = 3;                // best run is reported
+};
+
+// Keeps a ProjectilePool full of every kind of projectile over a level
+// with floors and pillars. Projectiles break, bounce and expire all the
+// time, and each tick tops the pool back up to the configured count. On top
+// of that, random handles are despawned, some of them already stale.
+// Prints the time per projectile per tick for update and collision, and the
+// cost of a spawn and a despawn. Returns 1 if the pool ever dropped a spawn
+// or reallocated its storage.
+int runProjectileBenchmark(const ProjectileBenchmarkConfig& config);
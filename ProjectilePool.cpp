@@ -0,0 +1,193 @@
+#include "ProjectilePool.h"
+
+ProjectilePool::ProjectilePool(std::size_t capacity) :
+    m_x(capacity), m_y(capacity), m_vx(capacity), m_vy(capacity),
+    m_width(capacity), m_height(capacity),
+    m_gravity(capacity),
+    m_bounce(capacity),
+    m_life(capacity),
+    m_collides(capacity),
+    m_kind(capacity),
+    m_slotOf(capacity),
+    m_indexOf(capacity, NoIndex),
+    m_generation(capacity, 0),
+    m_free(capacity),
+    m_probeX(capacity), m_probeY(capacity),
+    m_hitFloor(capacity), m_hitWall(capacity)
+{
+    clear();
+}
+
+std::optional<ProjectileHandle> ProjectilePool::spawn(ProjectileKind kind, sf::Vector2f position, sf::Vector2f velocity)
+{
+    if (m_freeCount == 0)
+    {
+        ++m_dropped;
+        return std::nullopt;
+    }
+
+    const std::uint32_t slot = m_free[--m_freeCount];
+    const std::size_t i = m_count++;
+    const ProjectileType& type = ProjectileTypes[static_cast<std::size_t>(kind)];
+
+    m_x[i] = position.x;
+    m_y[i] = position.y;
+    m_vx[i] = velocity.x;
+    m_vy[i] = velocity.y;
+    m_width[i] = type.size.x;
+    m_height[i] = type.size.y;
+    m_gravity[i] = type.gravity;
+    m_bounce[i] = type.bounceSpeed;
+    m_life[i] = type.lifetimeTicks;
+    m_collides[i] = type.collides ? 1 : 0;
+    m_kind[i] = kind;
+    m_slotOf[i] = slot;
+    m_indexOf[slot] = static_cast<std::uint32_t>(i);
+
+    return ProjectileHandle{ slot, m_generation[slot] };
+}
+
+bool ProjectilePool::despawn(ProjectileHandle handle)
+{
+    if (!alive(handle))
+        return false;
+    removeAt(m_indexOf[handle.slot]);
+    return true;
+}
+
+bool ProjectilePool::alive(ProjectileHandle handle) const
+{
+    return handle.slot < capacity() && m_indexOf[handle.slot] != NoIndex && m_generation[handle.slot] == handle.generation;
+}
+
+void ProjectilePool::removeAt(std::size_t index)
+{
+    const std::uint32_t slot = m_slotOf[index];
+    const std::size_t last = --m_count;
+    if (index != last)
+    {
+        m_x[index] = m_x[last];
+        m_y[index] = m_y[last];
+        m_vx[index] = m_vx[last];
+        m_vy[index] = m_vy[last];
+        m_width[index] = m_width[last];
+        m_height[index] = m_height[last];
+        m_gravity[index] = m_gravity[last];
+        m_bounce[index] = m_bounce[last];
+        m_life[index] = m_life[last];
+        m_collides[index] = m_collides[last];
+        m_kind[index] = m_kind[last];
+        m_slotOf[index] = m_slotOf[last];
+        m_indexOf[m_slotOf[index]] = static_cast<std::uint32_t>(index);
+    }
+
+    m_indexOf[slot] = NoIndex;
+    ++m_generation[slot];
+    m_free[m_freeCount++] = slot;
+}
+
+void ProjectilePool::clear()
+{
+    for (std::size_t i = 0; i < m_count; ++i)
+    {
+        m_indexOf[m_slotOf[i]] = NoIndex;
+        ++m_generation[m_slotOf[i]];
+    }
+    m_count = 0;
+
+    // lowest slot on top, so a fresh pool hands out slots in order
+    m_freeCount = capacity();
+    for (std::size_t i = 0; i < m_freeCount; ++i)
+        m_free[i] = static_cast<std::uint32_t>(m_freeCount - 1 - i);
+}
+
+void ProjectilePool::update(float dt, const TileGrid& tiles)
+{
+    const std::size_t n = m_count;
+    float* x = m_x.data();
+    float* y = m_y.data();
+    float* vx = m_vx.data();
+    float* vy = m_vy.data();
+    std::int32_t* life = m_life.data();
+    const float* width = m_width.data();
+    const float* height = m_height.data();
+    const float* gravity = m_gravity.data();
+    float* probeX = m_probeX.data();
+    float* probeY = m_probeY.data();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        vy[i] += gravity[i] * dt;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        life[i] -= 1;
+    }
+
+    // floor: middle of the bottom edge
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        probeX[i] = x[i] + width[i] * 0.5f;
+        probeY[i] = y[i] + height[i];
+    }
+    tiles.solidAt(probeX, probeY, n, m_hitFloor.data());
+
+    // wall: middle of whichever side it is moving towards
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        probeX[i] = x[i] + (vx[i] > 0.f ? width[i] : 0.f);
+        probeY[i] = y[i] + height[i] * 0.5f;
+    }
+    tiles.solidAt(probeX, probeY, n, m_hitWall.data());
+
+    const float left = tiles.origin().x;
+    const float right = left + static_cast<float>(tiles.columns()) * tiles.tileSize();
+    const float bottom = tiles.origin().y + static_cast<float>(tiles.rows()) * tiles.tileSize();
+
+    // Responses are rare and branchy, so they get a plain scalar pass. It runs
+    // back to front: removeAt moves the last projectile into the gap, and
+    // that one has already been handled.
+    for (std::size_t i = n; i-- > 0;)
+    {
+        bool dead = life[i] <= 0 || x[i] + width[i] < left || x[i] > right || y[i] > bottom;
+        if (!dead && m_collides[i])
+        {
+            if (m_hitWall[i])
+                dead = true;
+            else if (m_hitFloor[i] && vy[i] > 0.f)
+            {
+                if (m_bounce[i] > 0.f)
+                {
+                    y[i] = tiles.rowTop(y[i] + height[i]) - height[i];
+                    vy[i] = -m_bounce[i];
+                }
+                else
+                    dead = true;
+            }
+        }
+        if (dead)
+            removeAt(i);
+    }
+}
+
+ProjectileState ProjectilePool::state(std::size_t index) const
+{
+    return { { m_x[index], m_y[index] }, { m_vx[index], m_vy[index] }, m_kind[index] };
+}
+
+ProjectileHandle ProjectilePool::handle(std::size_t index) const
+{
+    const std::uint32_t slot = m_slotOf[index];
+    return { slot, m_generation[slot] };
+}
+
+void ProjectilePool::hash(StateHasher& hasher) const
+{
+    hasher.add(static_cast<std::uint64_t>(m_count));
+    for (std::size_t i = 0; i < m_count; ++i)
+    {
+        hasher.add(sf::Vector2f(m_x[i], m_y[i]));
+        hasher.add(sf::Vector2f(m_vx[i], m_vy[i]));
+        hasher.add(static_cast<std::uint32_t>(m_life[i]));
+        hasher.add(static_cast<std::uint8_t>(m_kind[i]));
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "ProjectileTypes.h"
+#include "StateHash.h"
+#include "TileGrid.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Refers to one projectile for as long as it lives. A handle kept past
+// despawn is harmless: the slot's generation has moved on, so it no longer matches.
+struct ProjectileHandle
+{
+    std::uint32_t slot = 0;
+    std::uint32_t generation = 0;
+};
+
+// One projectile as a plain record, for reporting and debugging.
+struct ProjectileState
+{
+    sf::Vector2f position;
+    sf::Vector2f velocity;
+    ProjectileKind kind = ProjectileKind::Fireball;
+};
+
+// Every live projectile, with a capacity fixed at construction. All memory
+// is allocated up front, so spawn and despawn are O(1) and never allocate.
+// Live projectiles are packed at the front of each column; despawning moves
+// the last one into the gap. Handles go through a slot table, so they
+// survive that move. Free slots are recycled through a stack.
+class ProjectilePool
+{
+public:
+    explicit ProjectilePool(std::size_t capacity);
+
+    // Nothing if the pool is full. Such spawns are counted in dropped().
+    std::optional<ProjectileHandle> spawn(ProjectileKind kind, sf::Vector2f position, sf::Vector2f velocity);
+
+    // False if the handle is stale, i.e. that projectile is already gone.
+    bool despawn(ProjectileHandle handle);
+    bool alive(ProjectileHandle handle) const;
+
+    // Removes the index-th live projectile; the last one takes its place.
+    void removeAt(std::size_t index);
+    void clear();
+
+    // Moves everything by dt, then tests all projectiles against the tiles
+    // in two batched queries: one for the floor, one for the leading edge.
+    // Projectiles bounce or break as their type says. Removes any that have
+    // expired or left the grid to the side or the bottom.
+    void update(float dt, const TileGrid& tiles);
+
+    std::size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+    std::size_t capacity() const { return m_slotOf.size(); }
+    std::size_t dropped() const { return m_dropped; }
+
+    // Live projectiles, indices 0 to size() - 1, in no particular order.
+    // Any spawn, despawn or update may reorder them.
+    const float* x() const { return m_x.data(); }
+    const float* y() const { return m_y.data(); }
+    const float* vx() const { return m_vx.data(); }
+    const float* vy() const { return m_vy.data(); }
+    const float* width() const { return m_width.data(); }
+    const float* height() const { return m_height.data(); }
+    const ProjectileKind* kind() const { return m_kind.data(); }
+
+    ProjectileState state(std::size_t index) const;
+    ProjectileHandle handle(std::size_t index) const;
+
+    void hash(StateHasher& hasher) const;
+
+private:
+    static constexpr std::uint32_t NoIndex = 0xFFFFFFFF;
+
+    // live projectiles, packed
+    std::size_t m_count = 0;
+    std::vector<float> m_x, m_y, m_vx, m_vy;
+    std::vector<float> m_width, m_height;
+    std::vector<float> m_gravity;
+    std::vector<float> m_bounce;
+    std::vector<std::int32_t> m_life;               // ticks left
+    std::vector<std::uint8_t> m_collides;
+    std::vector<ProjectileKind> m_kind;
+    std::vector<std::uint32_t> m_slotOf;            // packed index -> slot
+
+    // slots, which is what handles refer to
+    std::vector<std::uint32_t> m_indexOf;           // slot -> packed index, NoIndex when free
+    std::vector<std::uint32_t> m_generation;
+    std::vector<std::uint32_t> m_free;              // stack of free slots
+    std::size_t m_freeCount = 0;
+
+    // tile query scratch, sized to capacity like everything else
+    std::vector<float> m_probeX, m_probeY;
+    std::vector<std::uint8_t> m_hitFloor, m_hitWall;
+
+    std::size_t m_dropped = 0;
+};
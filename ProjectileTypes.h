@@ -0,0 +1,37 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+enum class ProjectileKind : std::uint8_t
+{
+    Fireball,       // Fire Mario; bounces along the floor, dies on walls
+    Hammer,         // Hammer Mario and Sledge Bros; arcs through everything
+    SpinyEgg,       // Lakitu; breaks when it lands
+    BulletBill,     // Bill Blasters; straight line, ignores tiles
+    Count
+};
+
+constexpr std::size_t ProjectileKindCount = static_cast<std::size_t>(ProjectileKind::Count);
+
+struct ProjectileType
+{
+    const char* name;
+    sf::Vector2f size;
+    float gravity;                  // pixels per second squared
+    float bounceSpeed;              // upwards speed after touching a floor; 0 breaks on the floor instead
+    std::uint16_t lifetimeTicks;
+    bool collides;                  // stopped by solid tiles
+    bool fromPlayer;                // hurts enemies rather than players
+};
+
+// ProjectileKind indexes this table, so keep the two in the same order.
+inline constexpr std::array<ProjectileType, ProjectileKindCount> ProjectileTypes{ {
+    //  name          size              gravity  bounce  life  collides fromPlayer
+    { "Fireball",    { 16.f, 16.f },   1400.f,  300.f,  180,  true,    true },
+    { "Hammer",      { 16.f, 16.f },   1000.f,    0.f,  180,  false,   false },
+    { "Spiny Egg",   { 16.f, 16.f },   1400.f,    0.f,  240,  true,    false },
+    { "Bullet Bill", { 32.f, 28.f },      0.f,    0.f,  600,  false,   false },
+} };
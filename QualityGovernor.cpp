@@ -0,0 +1,75 @@
+#include "QualityGovernor.h"
+#include "Profiler.h"
+
+#include <array>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    // Cheapest knob goes first: particles, then resolution.
+    constexpr std::array<QualitySettings, 5> Levels{ {
+        { 1.00f, 1.00f },
+        { 1.00f, 0.60f },
+        { 0.80f, 0.50f },
+        { 0.66f, 0.35f },
+        { 0.50f, 0.25f },
+    } };
+
+    // light smoothing so one hitch doesn't count as sustained pressure
+    constexpr float Smoothing = 0.2f;
+}
+
+QualityGovernor::QualityGovernor(float targetFrameMs) :
+    m_targetMs(targetFrameMs)
+{
+}
+
+const QualitySettings& QualityGovernor::settings() const
+{
+    return Levels[m_level];
+}
+
+std::size_t QualityGovernor::levelCount() const
+{
+    return Levels.size();
+}
+
+void QualityGovernor::update(float cpuMs, float frameMs, Profiler& profiler)
+{
+    m_smoothedCpuMs += (cpuMs - m_smoothedCpuMs) * Smoothing;
+    m_smoothedFrameMs += (frameMs - m_smoothedFrameMs) * Smoothing;
+
+    const bool missedDeadline = m_smoothedFrameMs > m_targetMs * 1.15f;
+    const bool cpuBound = m_smoothedCpuMs > m_targetMs * 0.9f;
+    const bool headroom = m_smoothedCpuMs < m_targetMs * 0.6f && m_smoothedFrameMs <= m_targetMs * 1.05f;
+
+    m_pressureFrames = (missedDeadline || cpuBound) ? m_pressureFrames + 1 : 0;
+    m_headroomFrames = headroom ? m_headroomFrames + 1 : 0;
+
+    const std::size_t previous = m_level;
+    if (m_pressureFrames >= FramesToDegrade && m_level + 1 < Levels.size())
+        ++m_level;
+    else if (m_headroomFrames >= FramesToRecover && m_level > 0)
+        --m_level;
+
+    if (m_level != previous)
+    {
+        m_pressureFrames = 0;
+        m_headroomFrames = 0;
+
+        std::ostringstream message;
+        message << std::fixed << std::setprecision(1)
+                << "quality " << previous << " -> " << m_level
+                << " (cpu " << m_smoothedCpuMs << " ms, frame " << m_smoothedFrameMs << " ms)";
+        profiler.note(message.str());
+    }
+
+    if (!m_levelSeries)
+    {
+        m_levelSeries = profiler.track("quality level");
+        m_scaleSeries = profiler.track("render scale %");
+    }
+    profiler.record(*m_levelSeries, static_cast<float>(m_level));
+    profiler.record(*m_scaleSeries, settings().renderScale * 100.f);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+class Profiler;
+
+// Render-side knobs the governor turns. None of them feed back into the
+// simulation, so gameplay stays deterministic whatever the level.
+struct QualitySettings
+{
+    float renderScale = 1.f;        // internal scene resolution relative to the window viewport
+    float particleDensity = 1.f;    // fraction of requested particles that actually spawn
+};
+
+// Watches frame timings and steps quality down quickly when frames run
+// late, and back up slowly once there has been headroom for a while.
+class QualityGovernor
+{
+public:
+    explicit QualityGovernor(float targetFrameMs = 1000.f / 60.f);
+
+    // cpuMs: update + draw submission. frameMs: full interval since the
+    // previous frame, which also catches a GPU that is falling behind
+    // (display() blocks on it). Don't feed frames spent sleeping on a static screen.
+    void update(float cpuMs, float frameMs, Profiler& profiler);
+
+    const QualitySettings& settings() const;
+    std::size_t level() const { return m_level; }
+    std::size_t levelCount() const;
+
+    void setTarget(float targetFrameMs) { m_targetMs = targetFrameMs; }
+
+private:
+    static constexpr int FramesToDegrade = 10;
+    static constexpr int FramesToRecover = 180;
+
+    float m_targetMs;
+    float m_smoothedCpuMs = 0.f;
+    float m_smoothedFrameMs = 0.f;
+    std::size_t m_level = 0;
+    int m_pressureFrames = 0;
+    int m_headroomFrames = 0;
+    std::optional<std::size_t> m_levelSeries;
+    std::optional<std::size_t> m_scaleSeries;
+};
@@ -0,0 +1,125 @@
+#include "Random.h"
+
+namespace
+{
+    constexpr std::size_t Lanes = 8;
+
+    std::uint64_t rotl(std::uint64_t x, int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    // Spreads any seed, even 0 or 1, into well-mixed words; also how the
+    // xoshiro authors recommend seeding.
+    std::uint64_t splitmix64(std::uint64_t& x)
+    {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Eight xoshiro256+ generators side by side, one per lane of each array.
+    struct LaneState
+    {
+        std::uint64_t s0[Lanes];
+        std::uint64_t s1[Lanes];
+        std::uint64_t s2[Lanes];
+        std::uint64_t s3[Lanes];
+
+        explicit LaneState(std::uint64_t seed)
+        {
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+            {
+                s0[lane] = splitmix64(seed);
+                s1[lane] = splitmix64(seed);
+                s2[lane] = splitmix64(seed);
+                s3[lane] = splitmix64(seed);
+            }
+        }
+
+        // One output per lane. Written lane-wise with no cross-lane
+        // dependency so it compiles to SIMD.
+        void step(std::uint64_t (&out)[Lanes])
+        {
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+            {
+                out[lane] = s0[lane] + s3[lane];
+                const std::uint64_t t = s1[lane] << 17;
+                s2[lane] ^= s0[lane];
+                s3[lane] ^= s1[lane];
+                s1[lane] ^= s2[lane];
+                s0[lane] ^= s3[lane];
+                s2[lane] ^= t;
+                s3[lane] = rotl(s3[lane], 45);
+            }
+        }
+    };
+}
+
+Random::Random(std::uint64_t seed, std::uint64_t stream)
+{
+    std::uint64_t x = seed ^ rotl(stream * 0xD1342543DE82EF95ull, 32);
+    for (std::uint64_t& word : m_state)
+        word = splitmix64(x);
+}
+
+std::uint64_t Random::next()
+{
+    const std::uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+    const std::uint64_t t = m_state[1] << 17;
+    m_state[2] ^= m_state[0];
+    m_state[3] ^= m_state[1];
+    m_state[1] ^= m_state[2];
+    m_state[0] ^= m_state[3];
+    m_state[2] ^= t;
+    m_state[3] = rotl(m_state[3], 45);
+    return result;
+}
+
+Random Random::split(std::uint64_t key) const
+{
+    std::uint64_t x = m_state[0] ^ rotl(m_state[1], 16) ^ rotl(m_state[2], 32) ^ rotl(m_state[3], 48);
+    return Random(splitmix64(x), key);
+}
+
+void Random::fill(float* out, std::size_t count, float min, float max)
+{
+    LaneState lanes(next());
+    const float scale = (max - min) * 0x1.0p-24f;
+
+    std::uint64_t bits[Lanes];
+    std::size_t i = 0;
+    for (; i + Lanes <= count; i += Lanes)
+    {
+        lanes.step(bits);
+        for (std::size_t lane = 0; lane < Lanes; ++lane)
+            out[i + lane] = min + static_cast<float>(static_cast<std::uint32_t>(bits[lane] >> 40)) * scale;
+    }
+    if (i < count)
+    {
+        lanes.step(bits);
+        for (std::size_t lane = 0; i < count; ++i, ++lane)
+            out[i] = min + static_cast<float>(static_cast<std::uint32_t>(bits[lane] >> 40)) * scale;
+    }
+}
+
+void Random::fill(std::uint32_t* out, std::size_t count)
+{
+    LaneState lanes(next());
+
+    std::uint64_t bits[Lanes];
+    std::size_t i = 0;
+    for (; i + Lanes <= count; i += Lanes)
+    {
+        lanes.step(bits);
+        for (std::size_t lane = 0; lane < Lanes; ++lane)
+            out[i + lane] = static_cast<std::uint32_t>(bits[lane] >> 32);
+    }
+    if (i < count)
+    {
+        lanes.step(bits);
+        for (std::size_t lane = 0; i < count; ++i, ++lane)
+            out[i] = static_cast<std::uint32_t>(bits[lane] >> 32);
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Deterministic random numbers for gameplay: xoshiro256** seeded through
+// splitmix64. The state is four words, so it can be saved, restored and
+// hashed along with everything else, and the same seed gives the same
+// sequence on every platform. std::rand and the std distributions don't
+// promise that.
+//
+// Each subsystem gets its own stream, so adding a roll in one place does
+// not shift the sequence everywhere else. For parallel work, split() makes a
+// child generator from the parent's state and a key such as a job index.
+// It doesn't advance the parent, so jobs can split off their own generators
+// without locking and in any order.
+class Random
+{
+public:
+    using State = std::array<std::uint64_t, 4>;
+
+    explicit Random(std::uint64_t seed = 0, std::uint64_t stream = 0);
+
+    std::uint64_t next();
+
+    // [0, 1) with 24 bits of precision
+    float nextFloat() { return static_cast<float>(next() >> 40) * 0x1.0p-24f; }
+
+    // [min, max)
+    float range(float min, float max) { return min + nextFloat() * (max - min); }
+
+    // [0, bound), without modulo bias worth worrying about for game-sized bounds
+    std::uint32_t below(std::uint32_t bound)
+    {
+        return static_cast<std::uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+
+    bool chance(float probability) { return nextFloat() < probability; }
+
+    Random split(std::uint64_t key) const;
+
+    // Bulk generation for particles and the like. Runs eight interleaved
+    // xoshiro256+ lanes, which need only adds, xors and shifts, so the
+    // compiler vectorizes the loop. Each call advances this generator by
+    // one step, whatever the count.
+    void fill(float* out, std::size_t count, float min = 0.f, float max = 1.f);
+    void fill(std::uint32_t* out, std::size_t count);
+
+    const State& state() const { return m_state; }
+    void setState(const State& state) { m_state = state; }
+
+private:
+    State m_state;
+};
+
+// Gameplay randomness is split by subsystem; see World::random().
+enum class RandomStream : std::uint8_t
+{
+    EnemyAI,
+    Particles,
+    LevelGeneration,
+    Count
+};
+
+constexpr std::size_t RandomStreamCount = static_cast<std::size_t>(RandomStream::Count);
+
+// For desync reports, in RandomStream order; a new stream needs its name here.
+constexpr auto RandomStreamNames = std::to_array<const char*>({ "enemyAI", "particles", "levelGeneration" });
+static_assert(RandomStreamNames.size() == RandomStreamCount);
@@ -0,0 +1,185 @@
+#include "SceneBatch.h"
+
+#include <SFML/Graphics/RenderStates.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+    // Two triangles covering rect, sampling texRect (in pixels).
+    void appendQuad(std::vector<sf::Vertex>& out, sf::FloatRect rect, sf::FloatRect texRect)
+    {
+        const sf::Vector2f tl = rect.position;
+        const sf::Vector2f br = rect.position + rect.size;
+        const sf::Vector2f ttl = texRect.position;
+        const sf::Vector2f tbr = texRect.position + texRect.size;
+
+        out.push_back({ tl, sf::Color::White, ttl });
+        out.push_back({ { br.x, tl.y }, sf::Color::White, { tbr.x, ttl.y } });
+        out.push_back({ { tl.x, br.y }, sf::Color::White, { ttl.x, tbr.y } });
+        out.push_back({ { tl.x, br.y }, sf::Color::White, { ttl.x, tbr.y } });
+        out.push_back({ { br.x, tl.y }, sf::Color::White, { tbr.x, ttl.y } });
+        out.push_back({ br, sf::Color::White, tbr });
+    }
+
+    // There is no projectile art yet, so each kind is a coloured block.
+    const std::array<sf::Color, ProjectileKindCount> ProjectileColors{
+        sf::Color(255, 120, 0),     // Fireball
+        sf::Color(150, 150, 160),   // Hammer
+        sf::Color(220, 30, 30),     // Spiny Egg
+        sf::Color(20, 20, 20),      // Bullet Bill
+    };
+
+    sf::FloatRect viewRect(const sf::View& view)
+    {
+        return sf::FloatRect(view.getCenter() - view.getSize() / 2.f, view.getSize());
+    }
+}
+
+void SpriteList::add(const sf::Texture& texture, sf::FloatRect bounds, sf::IntRect textureRect, bool flipX)
+{
+    m_sprites.push_back({ &texture, bounds, textureRect, flipX });
+}
+
+void ViewRenderList::build(const sf::View& view, PagedBackground& background, const SpriteList& sprites)
+{
+    m_view = view;
+    const sf::FloatRect visibleArea = viewRect(view);
+    m_backgroundVertices.clear();
+    background.appendVisible(visibleArea, m_backgroundVertices);
+
+    // cull, then group by texture so every texture is bound once per view;
+    // stable so sprites sharing a texture keep their submission order
+    m_visible.clear();
+    for (const SpriteList::Sprite& sprite : sprites.sprites())
+        if (sprite.bounds.findIntersection(visibleArea))
+            m_visible.push_back(&sprite);
+    std::stable_sort(m_visible.begin(), m_visible.end(),
+        [](const SpriteList::Sprite* a, const SpriteList::Sprite* b) { return a->texture < b->texture; });
+
+    m_vertices.clear();
+    m_batches.clear();
+    for (const SpriteList::Sprite* sprite : m_visible)
+    {
+        if (m_batches.empty() || m_batches.back().texture != sprite->texture)
+            m_batches.push_back({ sprite->texture, m_vertices.size(), 0 });
+
+        sf::FloatRect texRect(sf::Vector2f(sprite->textureRect.position), sf::Vector2f(sprite->textureRect.size));
+        if (sprite->flipX)
+        {
+            texRect.position.x += texRect.size.x;
+            texRect.size.x = -texRect.size.x;
+        }
+        appendQuad(m_vertices, sprite->bounds, texRect);
+        m_batches.back().count += 6;
+    }
+}
+
+void ViewRenderList::buildProjectiles(const ProjectilePool& projectiles, float rewind)
+{
+    const sf::FloatRect visibleArea = viewRect(m_view);
+    const float left = visibleArea.position.x;
+    const float top = visibleArea.position.y;
+    const float right = left + visibleArea.size.x;
+    const float bottom = top + visibleArea.size.y;
+
+    // straight from the pool's columns, no per-projectile sprite objects
+    m_shapeVertices.clear();
+    const float* x = projectiles.x();
+    const float* y = projectiles.y();
+    const float* vx = projectiles.vx();
+    const float* vy = projectiles.vy();
+    const float* width = projectiles.width();
+    const float* height = projectiles.height();
+    for (std::size_t i = 0; i < projectiles.size(); ++i)
+    {
+        const sf::Vector2f tl(x[i] - vx[i] * rewind, y[i] - vy[i] * rewind);
+        const sf::Vector2f br(tl.x + width[i], tl.y + height[i]);
+        if (br.x < left || tl.x > right || br.y < top || tl.y > bottom)
+            continue;
+
+        const sf::Color color = ProjectileColors[static_cast<std::size_t>(projectiles.kind()[i])];
+        m_shapeVertices.push_back({ tl, color });
+        m_shapeVertices.push_back({ { br.x, tl.y }, color });
+        m_shapeVertices.push_back({ { tl.x, br.y }, color });
+        m_shapeVertices.push_back({ { tl.x, br.y }, color });
+        m_shapeVertices.push_back({ { br.x, tl.y }, color });
+        m_shapeVertices.push_back({ br, color });
+    }
+}
+
+void ViewRenderList::appendPlatforms(const TransformHierarchy& transforms, const std::vector<Platform>& platforms,
+                                     float alpha)
+{
+    const sf::FloatRect visibleArea = viewRect(m_view);
+    const sf::Color color(200, 76, 12);
+    for (const Platform& platform : platforms)
+    {
+        const Transform2D world = interpolate(transforms.previous(platform.node), transforms.world(platform.node), alpha);
+        const sf::Vector2f half = platform.size / 2.f;
+        const sf::Vector2f tl = world.apply({ -half.x, -half.y });
+        const sf::Vector2f tr = world.apply({ half.x, -half.y });
+        const sf::Vector2f bl = world.apply({ -half.x, half.y });
+        const sf::Vector2f br = world.apply({ half.x, half.y });
+
+        const float reach = std::max(half.x, half.y) * 1.5f;     // covers any rotation
+        const sf::Vector2f centre = world.translation();
+        if (centre.x + reach < visibleArea.position.x || centre.x - reach > visibleArea.position.x + visibleArea.size.x
+            || centre.y + reach < visibleArea.position.y || centre.y - reach > visibleArea.position.y + visibleArea.size.y)
+            continue;
+
+        m_shapeVertices.push_back({ tl, color });
+        m_shapeVertices.push_back({ tr, color });
+        m_shapeVertices.push_back({ bl, color });
+        m_shapeVertices.push_back({ bl, color });
+        m_shapeVertices.push_back({ tr, color });
+        m_shapeVertices.push_back({ br, color });
+    }
+}
+
+void ViewRenderList::appendParticles(const ParticleSystem& particles)
+{
+    const sf::FloatRect visibleArea = viewRect(m_view);
+    const float half = 2.f;
+    for (const ParticleSystem::Particle& particle : particles.particles())
+    {
+        const sf::Vector2f tl = particle.position - sf::Vector2f(half, half);
+        const sf::Vector2f br = particle.position + sf::Vector2f(half, half);
+        if (!visibleArea.contains(particle.position))
+            continue;
+
+        m_shapeVertices.push_back({ tl, particle.color });
+        m_shapeVertices.push_back({ { br.x, tl.y }, particle.color });
+        m_shapeVertices.push_back({ { tl.x, br.y }, particle.color });
+        m_shapeVertices.push_back({ { tl.x, br.y }, particle.color });
+        m_shapeVertices.push_back({ { br.x, tl.y }, particle.color });
+        m_shapeVertices.push_back({ br, particle.color });
+    }
+}
+
+void ViewRenderList::draw(sf::RenderTarget& target, const PagedBackground& background) const
+{
+    target.setView(m_view);
+    if (!m_backgroundVertices.empty())
+    {
+        sf::RenderStates states;
+        states.texture = &background.texture();
+        target.draw(m_backgroundVertices.data(), m_backgroundVertices.size(), sf::PrimitiveType::Triangles, states);
+    }
+
+    for (const Batch& batch : m_batches)
+    {
+        sf::RenderStates states;
+        states.texture = batch.texture;
+        target.draw(m_vertices.data() + batch.first, batch.count, sf::PrimitiveType::Triangles, states);
+    }
+
+    if (!m_shapeVertices.empty())
+        target.draw(m_shapeVertices.data(), m_shapeVertices.size(), sf::PrimitiveType::Triangles);
+}
+
+std::size_t ViewRenderList::drawCalls() const
+{
+    return (m_backgroundVertices.empty() ? 0 : 1) + m_batches.size() + (m_shapeVertices.empty() ? 0 : 1);
+}
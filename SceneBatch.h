@@ -0,0 +1,74 @@
+#pragma once
+
+#include "PagedBackground.h"
+#include "ParticleSystem.h"
+#include "ProjectilePool.h"
+#include "World.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <cstddef>
+#include <vector>
+
+// Every sprite that may appear this frame, in world space. Filled once per
+// frame and shared by all views; each view only keeps what it can see.
+class SpriteList
+{
+public:
+    struct Sprite
+    {
+        const sf::Texture* texture;
+        sf::FloatRect bounds;       // world rect
+        sf::IntRect textureRect;
+        bool flipX;
+    };
+
+    void clear() { m_sprites.clear(); }
+    void add(const sf::Texture& texture, sf::FloatRect bounds, sf::IntRect textureRect, bool flipX = false);
+
+    const std::vector<Sprite>& sprites() const { return m_sprites; }
+
+private:
+    std::vector<Sprite> m_sprites;
+};
+
+// Culled, batched draw commands for one view: the visible background pages
+// in one draw plus one draw per texture for the sprites. Building and drawing are
+// separate so the cost of each view can be measured.
+class ViewRenderList
+{
+public:
+    // Also asks background for the pages around the view.
+    void build(const sf::View& view, PagedBackground& background, const SpriteList& sprites);
+    // After build(): every visible projectile as a flat quad, drawn on top in
+    // one call whatever their kind. rewind is how many seconds to move them
+    // back along their velocity, to match the interpolated players.
+    void buildProjectiles(const ProjectilePool& projectiles, float rewind);
+    // After buildProjectiles(): the moving platforms, drawn in the same call.
+    // Each platform's world transform, blended between the last two ticks, is
+    // applied to its corners as the vertices are written.
+    void appendPlatforms(const TransformHierarchy& transforms, const std::vector<Platform>& platforms, float alpha);
+    // And the effect particles, as small squares, in the same call again.
+    void appendParticles(const ParticleSystem& particles);
+    void draw(sf::RenderTarget& target, const PagedBackground& background) const;
+
+    std::size_t drawCalls() const;
+
+private:
+    struct Batch
+    {
+        const sf::Texture* texture;
+        std::size_t first;
+        std::size_t count;
+    };
+
+    sf::View m_view;
+    std::vector<sf::Vertex> m_backgroundVertices;
+    std::vector<sf::Vertex> m_vertices;     // reused frame to frame, no per-frame allocation once warm
+    std::vector<Batch> m_batches;
+    std::vector<const SpriteList::Sprite*> m_visible;
+    std::vector<sf::Vertex> m_shapeVertices;    // untextured: projectiles, platforms, particles
+};
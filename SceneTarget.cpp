@@ -0,0 +1,73 @@
+#include "SceneTarget.h"
+#include "Letterbox.h"
+
+#include <SFML/Graphics/Sprite.hpp>
+#include <algorithm>
+#include <iostream>
+
+sf::RenderTarget& SceneTarget::begin(sf::RenderWindow& window, const Letterbox& letterbox, float renderScale)
+{
+    m_offscreen = renderScale < 1.f;
+    if (!m_offscreen)
+    {
+        window.setView(letterbox.view());
+        return window;
+    }
+
+    const bool changed = m_letterboxRevision != letterbox.revision() || m_scale != renderScale;
+    if (m_failed && !changed)
+    {
+        m_offscreen = false;
+        window.setView(letterbox.view());
+        return window;
+    }
+
+    if (!m_texture || changed)
+    {
+        const sf::Vector2i viewport = letterbox.viewportPixels().size;
+        const sf::Vector2u size(
+            static_cast<unsigned>(std::max(1.f, static_cast<float>(viewport.x) * renderScale)),
+            static_cast<unsigned>(std::max(1.f, static_cast<float>(viewport.y) * renderScale)));
+
+        if (!m_texture)
+            m_texture.emplace();
+        m_letterboxRevision = letterbox.revision();
+        m_scale = renderScale;
+        m_failed = !m_texture->resize(size);
+        if (m_failed)
+        {
+            std::cerr << "Error: Failed to create scene render texture, drawing at full resolution" << std::endl;
+            m_texture.reset();
+            m_offscreen = false;
+            window.setView(letterbox.view());
+            return window;
+        }
+        m_texture->setSmooth(true);
+    }
+
+    m_texture->setView(sf::View(sf::FloatRect({ 0.f, 0.f }, letterbox.logicalSize())));
+    m_texture->clear();
+    return *m_texture;
+}
+
+sf::FloatRect SceneTarget::mapViewport(const sf::FloatRect& local, const Letterbox& letterbox) const
+{
+    if (m_offscreen)
+        return local;       // the texture covers exactly the play area
+
+    const sf::FloatRect outer = letterbox.view().getViewport();
+    return sf::FloatRect(outer.position + local.position.componentWiseMul(outer.size),
+                         local.size.componentWiseMul(outer.size));
+}
+
+void SceneTarget::end(sf::RenderWindow& window, const Letterbox& letterbox)
+{
+    window.setView(letterbox.view());
+    if (!m_offscreen)
+        return;
+
+    m_texture->display();
+    sf::Sprite scene(m_texture->getTexture());
+    scene.setScale(letterbox.logicalSize().componentWiseDiv(sf::Vector2f(m_texture->getSize())));
+    window.draw(scene);
+}
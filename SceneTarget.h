@@ -0,0 +1,36 @@
+#pragma once
+
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <optional>
+
+class Letterbox;
+
+// Where the game scene gets drawn. At full resolution that is the window
+// itself; below it, an offscreen texture that is stretched over the
+// letterboxed area afterwards. UI is drawn on the window after end() so it
+// stays sharp.
+class SceneTarget
+{
+public:
+    // Returns the target to draw the scene into, already set to the logical view.
+    // The texture is only (re)allocated here, when it is actually needed and
+    // the letterbox or the scale changed since the last allocation. If that
+    // fails the scene is drawn to the window, and the texture isn't tried
+    // again until the letterbox or the scale changes.
+    sf::RenderTarget& begin(sf::RenderWindow& window, const Letterbox& letterbox, float renderScale);
+
+    // Maps a viewport given relative to the logical play area (0..1) to a
+    // viewport of the target returned by the last begin(). Used for split screen.
+    sf::FloatRect mapViewport(const sf::FloatRect& local, const Letterbox& letterbox) const;
+
+    // Blits the offscreen scene to the window, if one was used.
+    void end(sf::RenderWindow& window, const Letterbox& letterbox);
+
+private:
+    std::optional<sf::RenderTexture> m_texture;
+    unsigned int m_letterboxRevision = 0;     // as of the last allocation, or the failed attempt
+    float m_scale = 0.f;
+    bool m_failed = false;
+    bool m_offscreen = false;
+};
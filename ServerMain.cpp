@@ -0,0 +1,261 @@
+#include "BattleServer.h"
+#include "BossBenchmark.h"
+#include "BotClient.h"
+#include "DesyncTest.h"
+#include "LoopbackTest.h"
+#include "MixerBenchmark.h"
+#include "ProjectileBenchmark.h"
+#include "TimerBenchmark.h"
+#include "TransformTest.h"
+
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+
+// Headless battle server.
+//
+//   supermario-server [--worlds N] [--threads N] [--port P] [--bots N] [--seconds S]
+//   supermario-server --connect HOST [--port P] --bots N [--seconds S]
+//   supermario-server --battle-bench WORLDS [--threads N] [--seconds S]
+//   supermario-server --loopback-test [--latency MS] [--jitter MS] [--loss PCT] [--seconds S]
+//   supermario-server --desync-test [--desync-at TICK] [--seconds S]
+//   supermario-server --transform-test
+//   supermario-server --boss-bench ACTORS
+//   supermario-server --projectile-bench PROJECTILES
+//   supermario-server --timer-bench TIMERS
+//   supermario-server --mixer-bench VOICES
+//
+// --bots starts N scripted clients in-process, which is the quickest way to
+// load a full server on one machine. With --connect, only the bots run,
+// pointed at a server somewhere else. --battle-bench times the server's
+// simulation alone, every world kept busy and no network in the way.
+// --loopback-test runs no network at
+// all: it measures how well JitterBuffer hides a bad link. --desync-test
+// runs two lockstep peers through DesyncDetector, optionally breaking one.
+// --transform-test checks reparenting in TransformHierarchy against a
+// recompute that ignores its ordering.
+// --boss-bench times coroutine boss scripts against hand-written state machines.
+// --projectile-bench stress-tests the projectile pool. --timer-bench times
+// the timer wheel against per-timer countdowns. --mixer-bench times the
+// software audio mixer with that many voices playing at once.
+
+namespace
+{
+    std::atomic<bool> running{ true };
+
+    void stop(int)
+    {
+        running = false;
+    }
+
+    void usage()
+    {
+        std::cerr << "usage: supermario-server [--worlds N] [--threads N] [--port P] [--bots N] [--seconds S]\n"
+                  << "       supermario-server --connect HOST [--port P] --bots N [--seconds S]\n"
+                  << "       supermario-server --battle-bench WORLDS [--threads N] [--seconds S]\n"
+                  << "       supermario-server --loopback-test [--latency MS] [--jitter MS] [--loss PCT] [--seconds S]\n"
+                  << "       supermario-server --desync-test [--desync-at TICK] [--seconds S]\n"
+                  << "       supermario-server --transform-test\n"
+                  << "       supermario-server --boss-bench ACTORS\n"
+                  << "       supermario-server --projectile-bench PROJECTILES\n"
+                  << "       supermario-server --timer-bench TIMERS\n"
+                  << "       supermario-server --mixer-bench VOICES" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    BattleConfig config;
+    std::size_t bots = 0;
+    float seconds = 0.f;
+    std::optional<std::string> connect;
+    bool loopbackTest = false;
+    LoopbackConfig loopback;
+    bool desyncTest = false;
+    bool transformTest = false;
+    DesyncConfig desync;
+    std::size_t bossBench = 0;
+    std::size_t projectileBench = 0;
+    std::size_t timerBench = 0;
+    std::size_t mixerBench = 0;
+    std::size_t battleBench = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--loopback-test")
+        {
+            loopbackTest = true;
+            continue;
+        }
+        if (arg == "--desync-test")
+        {
+            desyncTest = true;
+            continue;
+        }
+        if (arg == "--transform-test")
+        {
+            transformTest = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            usage();
+            return 1;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--worlds")
+            config.worldCount = std::strtoul(value, nullptr, 10);
+        else if (arg == "--threads")
+            config.threads = std::strtoul(value, nullptr, 10);
+        else if (arg == "--port")
+            config.port = static_cast<unsigned short>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--bots")
+            bots = std::strtoul(value, nullptr, 10);
+        else if (arg == "--seconds")
+            seconds = std::strtof(value, nullptr);
+        else if (arg == "--connect")
+            connect = value;
+        else if (arg == "--latency")
+            loopback.latencyMs = std::strtof(value, nullptr);
+        else if (arg == "--jitter")
+            loopback.jitterMs = std::strtof(value, nullptr);
+        else if (arg == "--loss")
+            loopback.lossPercent = std::strtof(value, nullptr);
+        else if (arg == "--desync-at")
+            desync.desyncAt = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--boss-bench")
+            bossBench = std::strtoul(value, nullptr, 10);
+        else if (arg == "--projectile-bench")
+            projectileBench = std::strtoul(value, nullptr, 10);
+        else if (arg == "--timer-bench")
+            timerBench = std::strtoul(value, nullptr, 10);
+        else if (arg == "--mixer-bench")
+            mixerBench = std::strtoul(value, nullptr, 10);
+        else if (arg == "--battle-bench")
+            battleBench = std::strtoul(value, nullptr, 10);
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (loopbackTest)
+    {
+        if (seconds > 0.f)
+            loopback.seconds = seconds;
+        return runLoopbackTest(loopback);
+    }
+    if (desyncTest)
+    {
+        if (seconds > 0.f)
+            desync.seconds = seconds;
+        return runDesyncTest(desync);
+    }
+    if (transformTest)
+        return runTransformTest({});
+    if (bossBench > 0)
+    {
+        BossBenchmarkConfig bench;
+        bench.actors = bossBench;
+        return runBossBenchmark(bench);
+    }
+    if (projectileBench > 0)
+    {
+        ProjectileBenchmarkConfig bench;
+        bench.projectiles = projectileBench;
+        return runProjectileBenchmark(bench);
+    }
+    if (timerBench > 0)
+    {
+        TimerBenchmarkConfig bench;
+        bench.timers = timerBench;
+        return runTimerBenchmark(bench);
+    }
+    if (mixerBench > 0)
+    {
+        MixerBenchmarkConfig bench;
+        bench.voices = mixerBench;
+        return runMixerBenchmark(bench);
+    }
+
+    if (battleBench > 0)
+    {
+        config.worldCount = battleBench;
+        BattleServer server(config);
+        server.benchmark(static_cast<std::uint32_t>((seconds > 0.f ? seconds : 30.f) * TickRate));
+        return 0;
+    }
+
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+
+    std::optional<std::thread> timer;
+    if (seconds > 0.f)
+    {
+        timer.emplace([seconds]
+        {
+            sf::Clock clock;
+            while (running && clock.getElapsedTime() < sf::seconds(seconds))
+                sf::sleep(sf::milliseconds(100));
+            running = false;
+        });
+    }
+
+    if (connect)
+    {
+        const std::optional<sf::IpAddress> address = sf::IpAddress::resolve(*connect);
+        if (!address || bots == 0)
+        {
+            if (!address)
+                std::cerr << "Error: Failed to resolve " << *connect << std::endl;
+            usage();
+            running = false;
+            if (timer)
+                timer->join();
+            return 1;
+        }
+
+        BotSwarm swarm(*address, config.port, bots);
+        swarm.run(running);
+    }
+    else
+    {
+        BattleServer server(config);
+        if (!server.listen())
+        {
+            running = false;
+            if (timer)
+                timer->join();
+            return 1;
+        }
+
+        std::optional<std::thread> botThread;
+        if (bots > 0)
+        {
+            botThread.emplace([&config, bots]
+            {
+                BotSwarm swarm(sf::IpAddress::LocalHost, config.port, bots);
+                swarm.run(running);
+            });
+        }
+
+        server.run(running);
+
+        if (botThread)
+            botThread->join();
+    }
+
+    if (timer)
+        timer->join();
+    return 0;
+}
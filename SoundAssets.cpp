@@ -0,0 +1,166 @@
+#include "SoundAssets.h"
+
+#include <SFML/Audio/OutputSoundFile.hpp>
+#include <SFML/System/Time.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+
+namespace
+{
+    double megabytes(std::uintmax_t bytes)
+    {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    std::filesystem::path stampPath(const std::filesystem::path& clip)
+    {
+        std::filesystem::path path = compressedSoundPath(clip);
+        return path += ".stamp";
+    }
+
+    // The clip's size and modification time, as ImageCache records its sources.
+    struct SourceStamp
+    {
+        std::uintmax_t size = 0;
+        std::int64_t time = 0;
+
+        bool operator==(const SourceStamp&) const = default;
+    };
+
+    std::optional<SourceStamp> currentStamp(const std::filesystem::path& clip)
+    {
+        std::error_code error;
+        SourceStamp stamp;
+        stamp.size = std::filesystem::file_size(clip, error);
+        if (error)
+            return std::nullopt;
+        stamp.time = static_cast<std::int64_t>(std::filesystem::last_write_time(clip, error).time_since_epoch().count());
+        if (error)
+            return std::nullopt;
+        return stamp;
+    }
+}
+
+std::filesystem::path compressedSoundPath(const std::filesystem::path& clip)
+{
+    std::filesystem::path path = clip;
+    return path.replace_extension(".ogg");
+}
+
+bool compressedSoundUpToDate(const std::filesystem::path& clip)
+{
+    const std::optional<SourceStamp> current = currentStamp(clip);
+    std::ifstream file(stampPath(clip));
+    SourceStamp recorded;
+    return current && file && (file >> recorded.size >> recorded.time) && recorded == *current
+        && std::filesystem::exists(compressedSoundPath(clip));
+}
+
+int transcodeLongSounds(const std::filesystem::path& directory)
+{
+    std::vector<std::filesystem::path> clips;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+        if (entry.is_regular_file() && entry.path().extension() == ".wav")
+            clips.push_back(entry.path());
+    if (error)
+    {
+        std::cerr << "Error: Failed to list " << directory.string() << ": " << error.message() << std::endl;
+        return 1;
+    }
+    std::sort(clips.begin(), clips.end());
+
+    // Resident audio is the decoded 16-bit samples; the header bytes of the
+    // WAVs aren't kept.
+    std::uintmax_t before = 0;
+    std::uintmax_t after = 0;
+    bool ok = true;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const std::filesystem::path& clip : clips)
+    {
+        sf::InputSoundFile input;
+        if (!input.openFromFile(clip))
+        {
+            std::cerr << "Error: Failed to open " << clip.string() << std::endl;
+            ok = false;
+            continue;
+        }
+        const std::uintmax_t decoded = input.getSampleCount() * sizeof(std::int16_t);
+        before += decoded;
+        if (input.getDuration().asSeconds() <= StreamAboveSeconds)
+        {
+            after += decoded;
+            continue;
+        }
+
+        // a copy already made from the clip as it is now is kept, so the build can run this every time
+        const std::filesystem::path target = compressedSoundPath(clip);
+        if (compressedSoundUpToDate(clip))
+        {
+            const std::uintmax_t compressed = std::filesystem::file_size(target, error);
+            after += error ? decoded : compressed;
+            continue;
+        }
+
+        std::vector<std::int16_t> samples(static_cast<std::size_t>(input.getSampleCount()));
+        samples.resize(static_cast<std::size_t>(input.read(samples.data(), samples.size())));
+        std::filesystem::remove(stampPath(clip), error);      // stale until the new copy is done
+        sf::OutputSoundFile output;
+        if (!output.openFromFile(target, input.getSampleRate(), input.getChannelCount(), input.getChannelMap()))
+        {
+            std::cerr << "Error: Failed to write " << target.string() << std::endl;
+            ok = false;
+            after += decoded;
+            continue;
+        }
+        output.write(samples.data(), samples.size());
+        output.close();
+
+        // written last, so a copy cut short by a crash is never taken as current
+        const std::optional<SourceStamp> stamp = currentStamp(clip);
+        std::ofstream stampFile(stampPath(clip), std::ios::trunc);
+        if (!stamp || !(stampFile << stamp->size << ' ' << stamp->time << '\n'))
+        {
+            std::cerr << "Error: Failed to write " << stampPath(clip).string() << std::endl;
+            ok = false;
+        }
+
+        const std::uintmax_t compressed = std::filesystem::file_size(target, error);
+        after += error ? decoded : compressed;
+        std::cout << std::setw(28) << std::left << clip.filename().string() << std::right
+                  << std::setw(8) << decoded / 1024 << " KB -> " << std::setw(6) << compressed / 1024 << " KB\n";
+    }
+    std::cout << "Resident audio: " << megabytes(before) << " MB all decoded, " << megabytes(after)
+              << " MB with clips over " << StreamAboveSeconds << " s compressed" << std::endl;
+    return ok ? 0 : 1;
+}
+
+bool CompressedSound::load(const std::filesystem::path& path, unsigned int sampleRate)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (!m_file.openFromMemory(m_data.data(), m_data.size()))
+        return false;
+    if (m_file.getChannelCount() != 1 || m_file.getSampleRate() != sampleRate)
+    {
+        std::cerr << "Warning: " << path.string() << " is not mono at " << sampleRate << " Hz" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void CompressedSound::rewind()
+{
+    m_file.seek(std::uint64_t{ 0 });
+}
+
+std::size_t CompressedSound::read(std::int16_t* out, std::size_t frames)
+{
+    return static_cast<std::size_t>(m_file.read(out, frames));
+}
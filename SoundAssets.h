@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Mixer.h"
+
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// Clips longer than this are stored compressed and decoded as they play;
+// shorter ones are the latency-critical effects and stay decoded.
+inline constexpr float StreamAboveSeconds = 2.f;
+
+// Where the compressed copy of a clip lives: beside it, as .ogg.
+std::filesystem::path compressedSoundPath(const std::filesystem::path& clip);
+
+// Whether clip has a compressed copy made from it as it is now. The asset
+// step stamps each copy with the clip's size and modification time, in a
+// .ogg.stamp file beside it; a copy with no stamp, or a stamp that no longer
+// matches, is stale and the clip is used instead.
+bool compressedSoundUpToDate(const std::filesystem::path& clip);
+
+// The asset step (supermario --transcode-sounds, run by the game's build
+// after linking): writes the compressed copy of every .wav in directory
+// longer than StreamAboveSeconds, through the Vorbis encoder SFML ships
+// with. Copies that are already up to date are left alone. Prints each
+// clip's size before and after, and the audio memory the whole directory
+// would take with and without the compressed copies. Returns 1 if any clip
+// failed.
+int transcodeLongSounds(const std::filesystem::path& directory);
+
+// A compressed clip held in memory and decoded on the mixing thread as it
+// plays. Only the compressed bytes and the decoder's state stay resident.
+class CompressedSound : public MixerStream
+{
+public:
+    // Reads the whole file; fails unless it is mono at sampleRate, like
+    // the mixer.
+    bool load(const std::filesystem::path& path, unsigned int sampleRate);
+
+    std::size_t compressedBytes() const { return m_data.size(); }
+    std::size_t decodedBytes() const { return static_cast<std::size_t>(m_file.getSampleCount()) * sizeof(std::int16_t); }
+
+    void rewind() override;
+    std::size_t read(std::int16_t* out, std::size_t frames) override;
+
+private:
+    std::vector<char> m_data;
+    sf::InputSoundFile m_file;
+};
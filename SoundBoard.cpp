@@ -0,0 +1,163 @@
+#include "SoundBoard.h"
+#include "AssetIds.h"
+
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Time.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <utility>
+
+namespace
+{
+    struct EventSound
+    {
+        std::optional<AssetId> sound;   // none is silent
+        bool positional;            // heard from where it happened, else everywhere
+        std::uint8_t maxVoices;     // at once, up to MaxVoicesPerSound
+    };
+
+    // By GameEventKind.
+    constexpr std::array<EventSound, GameEventKindCount> EventSounds{ {
+        //  sound                                   positional  voices
+        { AssetId::MarioSoundsSmbJumpSmallWav,      true,       2 },    // Jump
+        { AssetId::MarioSoundsSmbStompWav,          true,       4 },    // Stomp
+        { AssetId::MarioSoundsSmbKickWav,           true,       4 },    // Kick
+        { AssetId::MarioSoundsSmbPowerupWav,        false,      1 },    // PowerUp
+        { AssetId::MarioSoundsSmbFireballWav,       true,       3 },    // Fireball
+        { AssetId::MarioSoundsSmbPipeWav,           false,      1 },    // Pipe
+        { AssetId::MarioSoundsSmbFlagpoleWav,       false,      1 },    // Flagpole
+        { AssetId::MarioSoundsSmbWarningWav,        false,      1 },    // HurryUp
+        { AssetId::MarioSoundsSmbMariodieWav,       false,      1 },    // PlayerDied
+    } };
+
+    // Past the edge of the view, sounds fade out over this many pixels.
+    constexpr float FadeDistance = 400.f;
+    // How far across the stereo field the view's edges sit.
+    constexpr float PanWidth = 0.8f;
+
+    // Well under a tick, so a sound starts within a few ms of its event.
+    const sf::Time PollInterval = sf::milliseconds(2);
+}
+
+SoundBoard::SoundBoard(EventBus::Channel& channel) :
+    m_channel(channel)
+{
+    for (std::size_t i = 0; i < GameEventKindCount; ++i)
+    {
+        if (!EventSounds[i].sound)
+            continue;
+        const std::filesystem::path path = asset(*EventSounds[i].sound).path;
+        auto stream = std::make_unique<CompressedSound>();
+        if (compressedSoundUpToDate(path)
+            && stream->load(compressedSoundPath(path), m_mixer.mixer().sampleRate()))
+        {
+            m_residentBytes += stream->compressedBytes();
+            m_decodedBytes += stream->decodedBytes();
+            m_streams[i] = std::move(stream);
+            continue;
+        }
+
+        // an event whose sound holds the same bytes as an earlier one's shares its copy
+        const AssetId blob = asset(*EventSounds[i].sound).blob;
+        std::size_t same = 0;
+        while (same < i && !(m_sounds[same] && asset(*EventSounds[same].sound).blob == blob))
+            ++same;
+        if (same < i)
+        {
+            m_sounds[i] = m_sounds[same];
+            continue;
+        }
+
+        sf::SoundBuffer buffer;
+        if (!buffer.loadFromFile(path))
+        {
+            std::cerr << "Warning: Failed to load " << path.string() << std::endl;
+            continue;
+        }
+        m_sounds[i] = m_mixer.load(buffer);
+        const std::size_t bytes = m_mixer.mixer().sound(*m_sounds[i]).size() * sizeof(std::int16_t);
+        m_residentBytes += bytes;
+        m_decodedBytes += bytes;
+    }
+    m_mixer.play();
+    m_thread = std::thread(&SoundBoard::run, this);
+}
+
+SoundBoard::~SoundBoard()
+{
+    m_running = false;
+    m_thread.join();
+}
+
+void SoundBoard::run()
+{
+    while (m_running)
+    {
+        m_channel.drain([this](const GameEvent& event) { play(event); });
+        sf::sleep(PollInterval);
+    }
+}
+
+void SoundBoard::setListeners(std::span<const sf::FloatRect> views)
+{
+    const std::size_t count = std::min(views.size(), m_listeners.size());
+    for (std::size_t i = 0; i < count; ++i)
+        m_listeners[i].store(views[i].getCenter(), std::memory_order_relaxed);
+    if (count > 0)
+        m_hearingHalfSize.store(views[0].size / 2.f, std::memory_order_relaxed);
+    m_listenerCount.store(std::max<std::size_t>(count, 1), std::memory_order_relaxed);
+}
+
+void SoundBoard::play(const GameEvent& event)
+{
+    const auto kind = static_cast<std::size_t>(event.kind);
+    const EventSound& sound = EventSounds[kind];
+    if (!m_sounds[kind] && !m_streams[kind])
+        return;
+
+    float volume = 1.f;
+    float pan = 0.f;
+    if (sound.positional)
+    {
+        // heard by whichever camera is closest, by distance outside its view
+        const sf::Vector2f halfSize = m_hearingHalfSize.load(std::memory_order_relaxed);
+        float nearest = FadeDistance;
+        for (std::size_t i = 0; i < m_listenerCount.load(std::memory_order_relaxed); ++i)
+        {
+            const sf::Vector2f offset = event.position - m_listeners[i].load(std::memory_order_relaxed);
+            const float outsideX = std::max(0.f, std::abs(offset.x) - halfSize.x);
+            const float outsideY = std::max(0.f, std::abs(offset.y) - halfSize.y);
+            const float outside = std::sqrt(outsideX * outsideX + outsideY * outsideY);
+            if (outside < nearest)
+            {
+                nearest = outside;
+                pan = std::clamp(offset.x / halfSize.x, -1.f, 1.f) * PanWidth;
+            }
+        }
+        if (nearest >= FadeDistance)
+        {
+            m_culled.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        volume = 1.f - nearest / FadeDistance;
+    }
+
+    Mixer& mixer = m_mixer.mixer();
+    if (m_streams[kind])
+    {
+        m_voices[kind][0] = mixer.play(*m_streams[kind], volume, pan);     // restarts it
+        return;
+    }
+
+    // at the limit, the oldest copy makes way; stopping one that already finished is harmless
+    const std::size_t limit = std::clamp<std::size_t>(sound.maxVoices, 1, MaxVoicesPerSound);
+    std::uint8_t& oldest = m_oldestVoice[kind];
+    mixer.stop(m_voices[kind][oldest]);
+    m_voices[kind][oldest] = mixer.play(*m_sounds[kind], volume, pan);
+    oldest = static_cast<std::uint8_t>((oldest + 1) % limit);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "AudioMixer.h"
+#include "EventBus.h"
+#include "SoundAssets.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <thread>
+
+// Turns gameplay events into sounds. Runs on its own thread, draining the
+// event bus's audio channel a few hundred times a second, so the simulation
+// never waits on the audio backend and a slow frame never delays a sound.
+// Everything plays through one AudioMixer.
+//
+// Effects that happen somewhere, like stomps and fireballs, are heard from
+// the nearest camera: panned by where they are across its view, fading out
+// past its edges and not played at all further away. Each sound also has a
+// limit on how many copies play at once; one more restarts the oldest. So
+// however crowded the level, the voice count stays bounded.
+//
+// Short clips are kept decoded. Long ones play from their compressed copy
+// when the asset step has made one from the clip as it is now (see
+// transcodeLongSounds), and are decoded only while they play.
+class SoundBoard
+{
+public:
+    // Loads the event sounds and starts listening on channel.
+    explicit SoundBoard(EventBus::Channel& channel);
+    ~SoundBoard();
+
+    SoundBoard(const SoundBoard&) = delete;
+    SoundBoard& operator=(const SoundBoard&) = delete;
+
+    const AudioMixer& mixer() const { return m_mixer; }
+
+    // The cameras' views, one per player; from the render thread, each frame.
+    void setListeners(std::span<const sf::FloatRect> views);
+
+    // Positional events not played because nobody was near enough to hear them.
+    std::size_t culled() const { return m_culled.load(std::memory_order_relaxed); }
+
+    // Bytes of sound data held in memory, and what it would be with every clip decoded.
+    std::size_t residentBytes() const { return m_residentBytes; }
+    std::size_t decodedBytes() const { return m_decodedBytes; }
+
+private:
+    static constexpr std::size_t MaxVoicesPerSound = 4;
+
+    void run();
+    void play(const GameEvent& event);
+
+    EventBus::Channel& m_channel;
+    // declared before the mixer, so they outlive its streaming thread, which
+    // reads them until ~AudioMixer stops it
+    std::array<std::unique_ptr<CompressedSound>, GameEventKindCount> m_streams;
+    AudioMixer m_mixer;
+    std::array<std::optional<Mixer::SoundId>, GameEventKindCount> m_sounds;
+    std::size_t m_residentBytes = 0;
+    std::size_t m_decodedBytes = 0;
+    std::array<std::array<Mixer::VoiceId, MaxVoicesPerSound>, GameEventKindCount> m_voices{};
+    std::array<std::uint8_t, GameEventKindCount> m_oldestVoice{};
+
+    // written by the render thread, read by this one
+    std::array<std::atomic<sf::Vector2f>, MaxPlayers> m_listeners{};
+    std::atomic<sf::Vector2f> m_hearingHalfSize{ sf::Vector2f(540.f, 240.f) };
+    std::atomic<std::size_t> m_listenerCount{ 1 };
+    std::atomic<std::size_t> m_culled{ 0 };
+    std::atomic<bool> m_running{ true };
+    std::thread m_thread;
+};
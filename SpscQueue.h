@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Lock-free ring buffer for exactly one producer thread and one consumer
+// thread. The producer push()es items as they come and publish()es them all
+// at once, so a whole tick's worth costs the consumer one acquire and the
+// producer one release. Each side only ever writes its own index, and keeps
+// a cached copy of the other's so it rarely has to read the shared one.
+//
+// Capacity must be a power of two. A full queue drops new items rather than
+// waiting; dropped() says how many.
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    // Producer side.
+    bool push(const T& item)
+    {
+        if (m_staged - m_cachedHead == Capacity)
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (m_staged - m_cachedHead == Capacity)
+            {
+                ++m_dropped;
+                return false;
+            }
+        }
+        m_items[m_staged & (Capacity - 1)] = item;
+        ++m_staged;
+        return true;
+    }
+
+    // Makes everything pushed so far visible to the consumer.
+    void publish() { m_tail.store(m_staged, std::memory_order_release); }
+
+    std::size_t dropped() const { return m_dropped; }
+
+    // Consumer side. Calls consume(item) for every published item, oldest
+    // first, and returns how many there were.
+    template <typename Consume>
+    std::size_t drain(Consume&& consume)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_acquire);
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        const std::size_t count = tail - head;
+        for (; head != tail; ++head)
+            consume(m_items[head & (Capacity - 1)]);
+        m_head.store(head, std::memory_order_release);
+        return count;
+    }
+
+private:
+    // each side's index on its own cache line, so the two threads don't
+    // keep stealing the line from each other
+    alignas(64) std::atomic<std::size_t> m_head{ 0 };      // written by the consumer
+
+    alignas(64) std::atomic<std::size_t> m_tail{ 0 };      // written by the producer
+    std::size_t m_staged = 0;           // pushed, maybe not yet published
+    std::size_t m_cachedHead = 0;
+    std::size_t m_dropped = 0;
+
+    alignas(64) std::array<T, Capacity> m_items{};
+};
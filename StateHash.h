@@ -0,0 +1,95 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <cstring>
+
+// Streaming 64-bit hash for simulation state, built on the xxHash64 lane
+// round. Values are fed field by field, eight bytes at a time, so hashing
+// a struct never touches its padding. Floats are hashed by their bit
+// pattern: two simulations only agree if they produced exactly the same bits.
+class StateHasher
+{
+public:
+    explicit StateHasher(std::uint64_t seed = 0) : m_hash(seed + Prime5) {}
+
+    void add(std::uint64_t value)
+    {
+        std::uint64_t lane = value * Prime2;
+        lane = rotl(lane, 31) * Prime1;
+        m_hash ^= lane;
+        m_hash = rotl(m_hash, 27) * Prime1 + Prime4;
+    }
+
+    void add(std::uint32_t value) { add(static_cast<std::uint64_t>(value)); }
+    void add(std::uint16_t value) { add(static_cast<std::uint64_t>(value)); }
+    void add(std::uint8_t value) { add(static_cast<std::uint64_t>(value)); }
+    void add(bool value) { add(static_cast<std::uint64_t>(value)); }
+
+    void add(float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof bits);
+        add(bits);
+    }
+
+    void add(sf::Vector2f value)
+    {
+        std::uint32_t x;
+        std::uint32_t y;
+        std::memcpy(&x, &value.x, sizeof x);
+        std::memcpy(&y, &value.y, sizeof y);
+        add((static_cast<std::uint64_t>(x) << 32) | y);
+    }
+
+    std::uint64_t finish() const
+    {
+        std::uint64_t h = m_hash;
+        h ^= h >> 33;
+        h *= Prime2;
+        h ^= h >> 29;
+        h *= Prime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+private:
+    static constexpr std::uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+    static constexpr std::uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr std::uint64_t Prime3 = 0x165667B19E3779F9ull;
+    static constexpr std::uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+    static constexpr std::uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+    static std::uint64_t rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    std::uint64_t m_hash;
+};
+
+// One hash per subsystem, so a mismatch says straight away where to look.
+struct StateHashes
+{
+    std::uint32_t tick = 0;
+    std::uint64_t players = 0;
+    std::uint64_t enemies = 0;
+    std::uint64_t projectiles = 0;
+    std::uint64_t timers = 0;
+    std::uint64_t random = 0;
+
+    std::uint64_t combined() const
+    {
+        StateHasher hasher(tick);
+        hasher.add(players);
+        hasher.add(enemies);
+        hasher.add(projectiles);
+        hasher.add(timers);
+        hasher.add(random);
+        return hasher.finish();
+    }
+
+    bool operator==(const StateHashes& other) const
+    {
+        return tick == other.tick && players == other.players && enemies == other.enemies
+            && projectiles == other.projectiles && timers == other.timers && random == other.random;
+    }
+    bool operator!=(const StateHashes& other) const { return !(*this == other); }
+};
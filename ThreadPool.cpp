@@ -0,0 +1,84 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (std::size_t i = 1; i < threadCount; ++i)
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers)
+        worker.join();
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& job)
+{
+    if (count == 0)
+        return;
+
+    if (m_workers.empty() || count == 1)
+    {
+        job(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_job = &job;
+        m_count = count;
+        m_pending = m_workers.size();
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    runSlice(0);
+
+    std::unique_lock lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending == 0; });
+    m_job = nullptr;
+}
+
+void ThreadPool::workerLoop(std::size_t index)
+{
+    std::size_t seenGeneration = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stopping || m_generation != seenGeneration; });
+            if (m_stopping)
+                return;
+            seenGeneration = m_generation;
+        }
+
+        runSlice(index);
+
+        std::lock_guard lock(m_mutex);
+        if (--m_pending == 0)
+            m_done.notify_one();
+    }
+}
+
+void ThreadPool::runSlice(std::size_t index)
+{
+    // even split, the first (count % threads) slices take one extra item
+    const std::size_t threads = threadCount();
+    const std::size_t base = m_count / threads;
+    const std::size_t extra = m_count % threads;
+    const std::size_t begin = index * base + std::min(index, extra);
+    const std::size_t end = begin + base + (index < extra ? 1 : 0);
+
+    if (begin < end)
+        (*m_job)(begin, end);
+}
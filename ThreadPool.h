@@ -0,0 +1,43 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. parallelFor() hands
+// each thread one contiguous slice of the index range, so as long as the job
+// only touches the items in its own slice no locking is needed inside it.
+// The only synchronisation is one wake-up and one join per call.
+class ThreadPool
+{
+public:
+    // threadCount includes the calling thread; 0 picks one per hardware thread.
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t threadCount() const { return m_workers.size() + 1; }
+
+    // Calls job(begin, end) once per non-empty slice of [0, count) and
+    // returns when all slices are done. The caller works on the first slice.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& job);
+
+private:
+    void workerLoop(std::size_t index);
+    void runSlice(std::size_t index);
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(std::size_t, std::size_t)>* m_job = nullptr;
+    std::size_t m_count = 0;
+    std::size_t m_generation = 0;
+    std::size_t m_pending = 0;
+    bool m_stopping = false;
+};
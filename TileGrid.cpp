@@ -0,0 +1,66 @@
+#include "TileGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+TileGrid::TileGrid(sf::Vector2f origin, std::size_t columns, std::size_t rows, float tileSize) :
+    m_origin(origin),
+    m_columns(columns),
+    m_rows(rows),
+    m_tileSize(tileSize),
+    m_inverseTileSize(1.f / tileSize),
+    m_solid(columns * rows, 0)
+{
+}
+
+void TileGrid::setSolid(std::size_t column, std::size_t row, bool solid)
+{
+    if (column < m_columns && row < m_rows)
+        m_solid[row * m_columns + column] = solid ? 1 : 0;
+}
+
+void TileGrid::fillFrom(std::size_t row)
+{
+    for (std::size_t r = row; r < m_rows; ++r)
+        for (std::size_t c = 0; c < m_columns; ++c)
+            m_solid[r * m_columns + c] = 1;
+}
+
+bool TileGrid::solidAt(sf::Vector2f point) const
+{
+    std::uint8_t solid = 0;
+    solidAt(&point.x, &point.y, 1, &solid);
+    return solid != 0;
+}
+
+void TileGrid::solidAt(const float* x, const float* y, std::size_t n, std::uint8_t* out) const
+{
+    if (m_solid.empty())
+    {
+        std::fill(out, out + n, std::uint8_t{ 0 });
+        return;
+    }
+
+    const float columns = static_cast<float>(m_columns);
+    const float rows = static_cast<float>(m_rows);
+    const std::uint8_t* solid = m_solid.data();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float column = (x[i] - m_origin.x) * m_inverseTileSize;
+        const float row = (y[i] - m_origin.y) * m_inverseTileSize;
+        const bool inside = (column >= 0.f) & (column < columns) & (row >= 0.f) & (row < rows);
+        // Inside the grid both are non-negative, so truncating is flooring, and
+        // no std::floor call (a library call on plain SSE2) is needed. Outside
+        // points read tile 0 and throw the answer away, so the loop has no early exit.
+        const auto c = static_cast<std::int32_t>(inside ? column : 0.f);
+        const auto r = static_cast<std::int32_t>(inside ? row : 0.f);
+        const std::uint8_t tile = solid[static_cast<std::size_t>(r) * m_columns + static_cast<std::size_t>(c)];
+        out[i] = inside ? tile : 0;
+    }
+}
+
+float TileGrid::rowTop(float y) const
+{
+    return m_origin.y + std::floor((y - m_origin.y) * m_inverseTileSize) * m_tileSize;
+}
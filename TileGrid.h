@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Which tiles of the level are solid, one byte per tile. Anything outside
+// the grid counts as empty.
+class TileGrid
+{
+public:
+    TileGrid() = default;
+    // origin is the world position of tile (0, 0)'s top-left corner.
+    TileGrid(sf::Vector2f origin, std::size_t columns, std::size_t rows, float tileSize);
+
+    void setSolid(std::size_t column, std::size_t row, bool solid = true);
+    // Makes every tile from row down to the bottom of the grid solid.
+    void fillFrom(std::size_t row);
+
+    bool solidAt(sf::Vector2f point) const;
+
+    // solidAt for n points at once, writing 1 or 0 to out. Meant for whole
+    // columns of positions, e.g. every projectile's leading edge, so the grid
+    // lookup runs as one loop instead of a call per object.
+    void solidAt(const float* x, const float* y, std::size_t n, std::uint8_t* out) const;
+
+    // World y of the top edge of the row containing y.
+    float rowTop(float y) const;
+
+    sf::Vector2f origin() const { return m_origin; }
+    float tileSize() const { return m_tileSize; }
+    std::size_t columns() const { return m_columns; }
+    std::size_t rows() const { return m_rows; }
+
+private:
+    sf::Vector2f m_origin;
+    std::size_t m_columns = 0;
+    std::size_t m_rows = 0;
+    float m_tileSize = 32.f;
+    float m_inverseTileSize = 1.f / 32.f;
+    std::vector<std::uint8_t> m_solid;      // row-major
+};
@@ -0,0 +1,128 @@
+#include "TimerBenchmark.h"
+#include "Random.h"
+#include "TimerWheel.h"
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    struct RunResult
+    {
+        sf::Time ticks = sf::microseconds(std::numeric_limits<std::int64_t>::max());
+        sf::Time refresh;           // cancelling and rescheduling random timers
+        std::size_t fired = 0;
+        std::size_t refreshes = 0;
+        bool onTime = true;
+    };
+
+    RunResult runWheel(const TimerBenchmarkConfig& config)
+    {
+        RunResult result;
+        TimerWheel wheel(config.timers);
+        Random random(11, static_cast<std::uint64_t>(RandomStream::Particles));
+        std::vector<TimerHandle> handles(config.timers);
+        std::vector<std::uint32_t> due(config.timers);
+        std::vector<FiredTimer> fired;
+        fired.reserve(config.timers);
+
+        auto scheduleOne = [&](std::uint32_t id)
+        {
+            const std::uint32_t delay = 1 + random.below(config.maxDelay);
+            handles[id] = wheel.schedule(delay, TimerEvent::LevelClock, id).value_or(TimerHandle{});
+            due[id] = wheel.now() + delay;
+        };
+        for (std::uint32_t id = 0; id < config.timers; ++id)
+            scheduleOne(id);
+
+        auto refreshOne = [&]
+        {
+            const std::uint32_t id = random.below(static_cast<std::uint32_t>(config.timers));
+            result.onTime = wheel.cancel(handles[id]) && result.onTime;
+            scheduleOne(id);
+        };
+
+        // A tick is well under sf::Clock's microsecond resolution, so time whole loops.
+        sf::Clock clock;
+        for (std::uint32_t t = 0; t < config.ticks; ++t)
+        {
+            fired.clear();
+            wheel.advance(fired);
+            for (const FiredTimer& timer : fired)
+            {
+                result.onTime = result.onTime && due[timer.subject] == wheel.now();
+                scheduleOne(timer.subject);
+            }
+            result.fired += fired.size();
+        }
+        result.ticks = clock.restart();
+
+        result.refreshes = std::max<std::size_t>(1000, config.timers / 10);
+        for (std::size_t i = 0; i < result.refreshes; ++i)
+            refreshOne();
+        result.refresh = clock.getElapsedTime();
+        result.onTime = result.onTime && wheel.dropped() == 0;
+        return result;
+    }
+
+    // The obvious alternative: a countdown per timer, all decremented every tick.
+    RunResult runCountdowns(const TimerBenchmarkConfig& config)
+    {
+        RunResult result;
+        Random random(11, static_cast<std::uint64_t>(RandomStream::Particles));
+        std::vector<std::uint32_t> remaining(config.timers);
+        for (std::uint32_t& r : remaining)
+            r = 1 + random.below(config.maxDelay);
+
+        sf::Clock clock;
+        for (std::uint32_t t = 0; t < config.ticks; ++t)
+        {
+            for (std::uint32_t& r : remaining)
+            {
+                if (--r == 0)
+                {
+                    r = 1 + random.below(config.maxDelay);
+                    ++result.fired;
+                }
+            }
+        }
+        result.ticks = clock.getElapsedTime();
+        return result;
+    }
+}
+
+int runTimerBenchmark(const TimerBenchmarkConfig& config)
+{
+    if (config.timers == 0 || config.maxDelay == 0)
+        return 0;
+
+    RunResult wheel;
+    RunResult countdowns;
+    bool onTime = true;
+    for (int r = 0; r < std::max(1, config.repeats); ++r)
+    {
+        const RunResult w = runWheel(config);
+        onTime = onTime && w.onTime;
+        if (w.ticks < wheel.ticks)
+            wheel = w;
+        const RunResult c = runCountdowns(config);
+        if (c.ticks < countdowns.ticks)
+            countdowns = c;
+    }
+
+    const double ticks = config.ticks;
+    const double refreshes = static_cast<double>(std::max<std::size_t>(1, wheel.refreshes));
+    std::cout << std::fixed << std::setprecision(2)
+              << "Timers: " << config.timers << " pending x " << config.ticks << " ticks, delays up to "
+              << config.maxDelay << " ticks, best of " << config.repeats << "\n"
+              << "  timer wheel " << wheel.ticks.asMicroseconds() / ticks << " us/tick (" << wheel.fired << " fired), "
+              << wheel.refresh.asMicroseconds() * 1000.0 / refreshes << " ns per cancel + reschedule\n"
+              << "  countdowns  " << countdowns.ticks.asMicroseconds() / ticks << " us/tick (" << countdowns.fired << " fired)\n"
+              << "  " << (onTime ? "every timer fired on its tick" : "some timers fired late, early or not at all") << std::endl;
+    return onTime ? 0 : 1;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct TimerBenchmarkConfig
+{
+    std::size_t timers = 10000;
+    std::uint32_t ticks = 3600;
+    std::uint32_t maxDelay = 6000;  // ticks; delays are uniform from 1 up to this
+    int repeats = 3;                // best run is reported
+};
+
+// Keeps the configured number of timers pending on a TimerWheel, rescheduling
+// every timer that fires. For comparison, the same load runs as a plain
+// array of countdowns scanned every tick. Prints the cost per tick of both.
+// Then it cancels and reschedules random timers, the way a power-up gets
+// refreshed, and prints the cost of that too. Returns 1 if any timer fired
+// on the wrong tick.
+int runTimerBenchmark(const TimerBenchmarkConfig& config);
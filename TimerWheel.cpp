@@ -0,0 +1,157 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+TimerWheel::TimerWheel(std::size_t capacity) :
+    m_due(capacity),
+    m_event(capacity),
+    m_subject(capacity),
+    m_next(capacity),
+    m_prev(capacity, NoIndex),
+    m_bucket(capacity, NoIndex),
+    m_generation(capacity, 1)
+{
+    m_head.fill(NoIndex);
+    m_tail.fill(NoIndex);
+
+    // free list in index order, so a fresh wheel hands out node 0 first
+    for (std::size_t i = 0; i < capacity; ++i)
+        m_next[i] = i + 1 < capacity ? static_cast<std::uint32_t>(i + 1) : NoIndex;
+    m_freeHead = capacity > 0 ? 0 : NoIndex;
+}
+
+std::optional<TimerHandle> TimerWheel::schedule(std::uint32_t delayTicks, TimerEvent event, std::uint32_t subject)
+{
+    if (m_freeHead == NoIndex)
+    {
+        ++m_dropped;
+        return std::nullopt;
+    }
+
+    const std::uint32_t node = m_freeHead;
+    m_freeHead = m_next[node];
+
+    m_due[node] = m_now + std::clamp<std::uint32_t>(delayTicks, 1, MaxDelay);
+    m_event[node] = event;
+    m_subject[node] = subject;
+    link(node, bucketFor(m_due[node]));
+    ++m_size;
+    return TimerHandle{ node, m_generation[node] };
+}
+
+bool TimerWheel::cancel(TimerHandle handle)
+{
+    if (!pending(handle))
+        return false;
+    unlink(handle.slot);
+    release(handle.slot);
+    return true;
+}
+
+bool TimerWheel::pending(TimerHandle handle) const
+{
+    return handle.slot < capacity() && m_bucket[handle.slot] != NoIndex && m_generation[handle.slot] == handle.generation;
+}
+
+std::uint32_t TimerWheel::remaining(TimerHandle handle) const
+{
+    return pending(handle) ? m_due[handle.slot] - m_now : 0;
+}
+
+void TimerWheel::advance(std::vector<FiredTimer>& fired)
+{
+    ++m_now;
+
+    // Level n comes round whenever the low 6n bits of now are all zero.
+    // Coarsest first, so a timer can drop through several levels in one go.
+    std::uint32_t top = 0;
+    while (top + 1 < Levels && (m_now & ((1u << (SlotBits * (top + 1))) - 1)) == 0)
+        ++top;
+    for (std::uint32_t level = top; level > 0; --level)
+        cascade(level);
+
+    // everything in the finest level's current bucket is due now
+    const std::uint32_t bucket = m_now & SlotMask;
+    std::uint32_t node = m_head[bucket];
+    m_head[bucket] = m_tail[bucket] = NoIndex;
+    while (node != NoIndex)
+    {
+        const std::uint32_t next = m_next[node];
+        fired.push_back({ m_event[node], m_subject[node] });
+        release(node);
+        node = next;
+    }
+}
+
+void TimerWheel::hash(StateHasher& hasher) const
+{
+    hasher.add(m_now);
+    hasher.add(static_cast<std::uint64_t>(m_size));
+    for (std::size_t i = 0; i < capacity(); ++i)
+    {
+        if (m_bucket[i] == NoIndex)
+            continue;
+        hasher.add(static_cast<std::uint32_t>(i));
+        hasher.add(m_due[i]);
+        hasher.add(static_cast<std::uint8_t>(m_event[i]));
+        hasher.add(m_subject[i]);
+    }
+}
+
+std::uint32_t TimerWheel::bucketFor(std::uint32_t due) const
+{
+    // the finest level where due and now only differ within one bucket's range
+    const std::uint32_t differs = due ^ m_now;
+    std::uint32_t level = 0;
+    while (level + 1 < Levels && (differs >> (SlotBits * (level + 1))) != 0)
+        ++level;
+    return level * Slots + ((due >> (SlotBits * level)) & SlotMask);
+}
+
+void TimerWheel::link(std::uint32_t node, std::uint32_t bucket)
+{
+    m_bucket[node] = bucket;
+    m_next[node] = NoIndex;
+    m_prev[node] = m_tail[bucket];
+    if (m_tail[bucket] != NoIndex)
+        m_next[m_tail[bucket]] = node;
+    else
+        m_head[bucket] = node;
+    m_tail[bucket] = node;
+}
+
+void TimerWheel::unlink(std::uint32_t node)
+{
+    const std::uint32_t bucket = m_bucket[node];
+    if (m_prev[node] != NoIndex)
+        m_next[m_prev[node]] = m_next[node];
+    else
+        m_head[bucket] = m_next[node];
+    if (m_next[node] != NoIndex)
+        m_prev[m_next[node]] = m_prev[node];
+    else
+        m_tail[bucket] = m_prev[node];
+}
+
+void TimerWheel::release(std::uint32_t node)
+{
+    m_bucket[node] = NoIndex;
+    m_prev[node] = NoIndex;
+    ++m_generation[node];
+    m_next[node] = m_freeHead;
+    m_freeHead = node;
+    --m_size;
+}
+
+void TimerWheel::cascade(std::uint32_t level)
+{
+    const std::uint32_t bucket = level * Slots + ((m_now >> (SlotBits * level)) & SlotMask);
+    std::uint32_t node = m_head[bucket];
+    m_head[bucket] = m_tail[bucket] = NoIndex;
+    while (node != NoIndex)
+    {
+        const std::uint32_t next = m_next[node];
+        link(node, bucketFor(m_due[node]));
+        node = next;
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "StateHash.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// What a timer means when it fires. The wheel itself doesn't care; the
+// owner switches on it.
+enum class TimerEvent : std::uint8_t
+{
+    LevelClock,         // one unit of the level timer has passed
+    StarPowerEnd,       // subject: player index
+    InvincibilityEnd,   // subject: player index
+};
+
+struct FiredTimer
+{
+    TimerEvent event;
+    std::uint32_t subject;
+};
+
+// Refers to one scheduled timer. Generations start at 1, so a
+// default-constructed handle never matches a live timer.
+struct TimerHandle
+{
+    std::uint32_t slot = 0;
+    std::uint32_t generation = 0;
+};
+
+// Timers keyed on simulation ticks, in a hierarchical wheel: four levels of
+// 64 buckets, each level 64 times coarser than the one below. A timer sits
+// in the finest level that can still tell its tick apart from now. When a
+// coarser bucket comes round, its timers are spread over the levels below.
+// Schedule and cancel are O(1). A tick costs one bucket, plus a cascade
+// every 64 ticks, however many timers are pending.
+//
+// Timers live in a node array allocated once at construction. Buckets are
+// linked lists threaded through it by index, not pointer, so copying the
+// wheel, e.g. into a desync snapshot, just copies the arrays.
+class TimerWheel
+{
+public:
+    static constexpr std::uint32_t MaxDelay = (1u << 24) - 64;     // about 77 hours at 60 Hz
+
+    explicit TimerWheel(std::size_t capacity);
+
+    // Fires delayTicks advance() calls from now, the earliest being the
+    // next one, so 0 counts as 1. Longer delays are clamped to MaxDelay.
+    // Nothing if all capacity timers are pending; that is counted in dropped().
+    std::optional<TimerHandle> schedule(std::uint32_t delayTicks, TimerEvent event, std::uint32_t subject = 0);
+
+    // False if the timer already fired or was cancelled.
+    bool cancel(TimerHandle handle);
+    bool pending(TimerHandle handle) const;
+    // Ticks until it fires, 0 if it isn't pending.
+    std::uint32_t remaining(TimerHandle handle) const;
+
+    // Moves time on one tick and appends the timers that came due to fired.
+    // Timers due on the same tick always come out in the same order, so
+    // replays and lockstep peers agree.
+    void advance(std::vector<FiredTimer>& fired);
+
+    std::uint32_t now() const { return m_now; }
+    std::size_t size() const { return m_size; }
+    std::size_t capacity() const { return m_due.size(); }
+    std::size_t dropped() const { return m_dropped; }
+
+    void hash(StateHasher& hasher) const;
+
+private:
+    static constexpr std::uint32_t Levels = 4;
+    static constexpr std::uint32_t SlotBits = 6;
+    static constexpr std::uint32_t Slots = 1u << SlotBits;
+    static constexpr std::uint32_t SlotMask = Slots - 1;
+    static constexpr std::uint32_t NoIndex = 0xFFFFFFFF;
+
+    std::uint32_t bucketFor(std::uint32_t due) const;
+    void link(std::uint32_t node, std::uint32_t bucket);
+    void unlink(std::uint32_t node);
+    void release(std::uint32_t node);
+    void cascade(std::uint32_t level);
+
+    std::uint32_t m_now = 0;
+    std::size_t m_size = 0;
+    std::size_t m_dropped = 0;
+
+    // nodes
+    std::vector<std::uint32_t> m_due;
+    std::vector<TimerEvent> m_event;
+    std::vector<std::uint32_t> m_subject;
+    std::vector<std::uint32_t> m_next;          // in its bucket, or in the free list
+    std::vector<std::uint32_t> m_prev;
+    std::vector<std::uint32_t> m_bucket;        // NoIndex when free
+    std::vector<std::uint32_t> m_generation;
+    std::uint32_t m_freeHead = NoIndex;
+
+    // level * Slots + slot
+    std::array<std::uint32_t, Levels * Slots> m_head;
+    std::array<std::uint32_t, Levels * Slots> m_tail;
+};
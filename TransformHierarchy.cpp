@@ -0,0 +1,120 @@
+#include "TransformHierarchy.h"
+
+#include <cmath>
+
+Transform2D Transform2D::make(sf::Vector2f position, float radians)
+{
+    const float cosine = std::cos(radians);
+    const float sine = std::sin(radians);
+    return { cosine, -sine, position.x, sine, cosine, position.y };
+}
+
+Transform2D interpolate(const Transform2D& previous, const Transform2D& current, float alpha)
+{
+    auto blend = [alpha](float p, float c) { return p + (c - p) * alpha; };
+    return { blend(previous.a, current.a), blend(previous.b, current.b), blend(previous.tx, current.tx),
+             blend(previous.c, current.c), blend(previous.d, current.d), blend(previous.ty, current.ty) };
+}
+
+TransformHierarchy::NodeId TransformHierarchy::add(NodeId parent, sf::Vector2f localPosition, float localRotation)
+{
+    // appending keeps parents first, since the parent already exists
+    const auto id = static_cast<NodeId>(m_indexOf.size());
+    const auto index = static_cast<std::uint32_t>(m_parent.size());
+    const std::uint32_t parentIndex = parent == NoParent ? NoParent : m_indexOf[parent];
+    const Transform2D local = Transform2D::make(localPosition, localRotation);
+    const Transform2D world = parentIndex == NoParent ? local : m_world[parentIndex] * local;
+
+    m_parent.push_back(parentIndex);
+    m_localPosition.push_back(localPosition);
+    m_localRotation.push_back(localRotation);
+    m_local.push_back(local);
+    m_world.push_back(world);
+    m_previous.push_back(world);
+    m_idOf.push_back(id);
+    m_indexOf.push_back(index);
+    return id;
+}
+
+void TransformHierarchy::setLocal(NodeId node, sf::Vector2f position, float rotation)
+{
+    const std::uint32_t i = m_indexOf[node];
+    m_localPosition[i] = position;
+    m_localRotation[i] = rotation;
+    m_local[i] = Transform2D::make(position, rotation);
+}
+
+void TransformHierarchy::setParent(NodeId node, NodeId parent)
+{
+    const std::uint32_t index = m_indexOf[node];
+    const std::uint32_t parentIndex = parent == NoParent ? NoParent : m_indexOf[parent];
+    if (parentIndex != NoParent && isAncestor(index, parentIndex))
+        return;
+    m_parent[index] = parentIndex;
+    if (parentIndex == NoParent || parentIndex < index)
+        return;     // order still holds
+
+    // New order: each node right after its ancestors, otherwise as before.
+    const std::size_t n = m_parent.size();
+    std::vector<std::uint32_t> order;
+    std::vector<std::uint32_t> newIndex(n, NoParent);
+    std::vector<std::uint32_t> chain;
+    order.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::uint32_t j = static_cast<std::uint32_t>(i); j != NoParent && newIndex[j] == NoParent; j = m_parent[j])
+            chain.push_back(j);
+        while (!chain.empty())
+        {
+            newIndex[chain.back()] = static_cast<std::uint32_t>(order.size());
+            order.push_back(chain.back());
+            chain.pop_back();
+        }
+    }
+
+    auto permute = [&order](auto& column)
+    {
+        auto reordered = column;
+        for (std::size_t i = 0; i < order.size(); ++i)
+            reordered[i] = column[order[i]];
+        column.swap(reordered);
+    };
+    permute(m_parent);
+    permute(m_localPosition);
+    permute(m_localRotation);
+    permute(m_local);
+    permute(m_world);
+    permute(m_previous);
+    permute(m_idOf);
+    for (std::uint32_t& p : m_parent)
+        if (p != NoParent)
+            p = newIndex[p];
+    for (std::size_t i = 0; i < n; ++i)
+        m_indexOf[m_idOf[i]] = static_cast<std::uint32_t>(i);
+}
+
+TransformHierarchy::NodeId TransformHierarchy::parent(NodeId node) const
+{
+    const std::uint32_t p = m_parent[m_indexOf[node]];
+    return p == NoParent ? NoParent : m_idOf[p];
+}
+
+void TransformHierarchy::update()
+{
+    m_previous = m_world;
+
+    const std::size_t n = m_parent.size();
+    const std::uint32_t* parent = m_parent.data();
+    const Transform2D* local = m_local.data();
+    Transform2D* world = m_world.data();
+    for (std::size_t i = 0; i < n; ++i)
+        world[i] = parent[i] == NoParent ? local[i] : world[parent[i]] * local[i];
+}
+
+bool TransformHierarchy::isAncestor(std::size_t ancestor, std::size_t index) const
+{
+    for (std::size_t i = index; i != NoParent; i = m_parent[i])
+        if (i == ancestor)
+            return true;
+    return false;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 2D affine transform: rotation and translation, as the top two rows of a
+// 3x3 matrix. sf::Transform would do, but it lives in the graphics
+// module, and the simulation has to build without it.
+struct Transform2D
+{
+    float a = 1.f, b = 0.f, tx = 0.f;
+    float c = 0.f, d = 1.f, ty = 0.f;
+
+    static Transform2D make(sf::Vector2f position, float radians);
+
+    sf::Vector2f apply(sf::Vector2f p) const { return { a * p.x + b * p.y + tx, c * p.x + d * p.y + ty }; }
+    sf::Vector2f translation() const { return { tx, ty }; }
+
+    // this * child: child's space into this one's parent space
+    Transform2D operator*(const Transform2D& child) const
+    {
+        return { a * child.a + b * child.c, a * child.b + b * child.d, a * child.tx + b * child.ty + tx,
+                 c * child.a + d * child.c, c * child.b + d * child.d, c * child.tx + d * child.ty + ty };
+    }
+};
+
+// Elementwise blend. Close enough for the small steps between two ticks.
+Transform2D interpolate(const Transform2D& previous, const Transform2D& current, float alpha);
+
+// Parent/child transforms kept as flat arrays, parents always before their
+// children, so one front-to-back pass computes every world transform. Nodes
+// are referred to by id, which stays valid when reparenting reorders the arrays.
+class TransformHierarchy
+{
+public:
+    using NodeId = std::uint32_t;
+    static constexpr NodeId NoParent = 0xFFFFFFFF;
+
+    NodeId add(NodeId parent, sf::Vector2f localPosition, float localRotation = 0.f);
+
+    void setLocal(NodeId node, sf::Vector2f position, float rotation = 0.f);
+    sf::Vector2f localPosition(NodeId node) const { return m_localPosition[m_indexOf[node]]; }
+
+    // Moves node, and everything under it, under parent. Costs a pass over
+    // all nodes to restore the ordering, so it is for the occasional pickup
+    // or drop, not every tick. A parent that is node itself or one of its
+    // children is ignored.
+    void setParent(NodeId node, NodeId parent);
+    NodeId parent(NodeId node) const;
+
+    // Recomputes every world transform; what they were goes to previous(),
+    // for render interpolation.
+    void update();
+
+    const Transform2D& world(NodeId node) const { return m_world[m_indexOf[node]]; }
+    const Transform2D& previous(NodeId node) const { return m_previous[m_indexOf[node]]; }
+
+    std::size_t size() const { return m_parent.size(); }
+
+private:
+    bool isAncestor(std::size_t ancestor, std::size_t index) const;
+
+    // by index, parents first
+    std::vector<std::uint32_t> m_parent;        // index, or NoParent
+    std::vector<sf::Vector2f> m_localPosition;
+    std::vector<float> m_localRotation;
+    std::vector<Transform2D> m_local;
+    std::vector<Transform2D> m_world;
+    std::vector<Transform2D> m_previous;
+    std::vector<NodeId> m_idOf;
+
+    std::vector<std::uint32_t> m_indexOf;       // by id
+};
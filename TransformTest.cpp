@@ -0,0 +1,101 @@
+#include "TransformTest.h"
+#include "Random.h"
+#include "TransformHierarchy.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    // What the hierarchy should hold, by node id, kept without any ordering.
+    struct Reference
+    {
+        std::vector<TransformHierarchy::NodeId> parent;
+        std::vector<sf::Vector2f> position;
+        std::vector<float> rotation;
+
+        bool isAncestor(TransformHierarchy::NodeId ancestor, TransformHierarchy::NodeId node) const
+        {
+            for (TransformHierarchy::NodeId i = node; i != TransformHierarchy::NoParent; i = parent[i])
+                if (i == ancestor)
+                    return true;
+            return false;
+        }
+
+        Transform2D world(TransformHierarchy::NodeId node) const
+        {
+            const Transform2D local = Transform2D::make(position[node], rotation[node]);
+            return parent[node] == TransformHierarchy::NoParent ? local : world(parent[node]) * local;
+        }
+    };
+
+    bool close(const Transform2D& a, const Transform2D& b)
+    {
+        constexpr float Tolerance = 1e-3f;
+        return std::abs(a.a - b.a) < Tolerance && std::abs(a.b - b.b) < Tolerance && std::abs(a.tx - b.tx) < Tolerance
+            && std::abs(a.c - b.c) < Tolerance && std::abs(a.d - b.d) < Tolerance && std::abs(a.ty - b.ty) < Tolerance;
+    }
+}
+
+int runTransformTest(const TransformTestConfig& config)
+{
+    Random rng(config.seed);
+    TransformHierarchy hierarchy;
+    Reference reference;
+
+    // each node under an earlier one or under nothing, as add() requires
+    for (std::size_t i = 0; i < config.nodes; ++i)
+    {
+        const auto parent = i == 0 || rng.chance(0.2f) ? TransformHierarchy::NoParent
+                                                       : static_cast<TransformHierarchy::NodeId>(rng.below(static_cast<std::uint32_t>(i)));
+        const sf::Vector2f position{ rng.range(-50.f, 50.f), rng.range(-50.f, 50.f) };
+        const float rotation = rng.range(-3.f, 3.f);
+        hierarchy.add(parent, position, rotation);
+        reference.parent.push_back(parent);
+        reference.position.push_back(position);
+        reference.rotation.push_back(rotation);
+    }
+
+    const auto count = static_cast<std::uint32_t>(config.nodes);
+    std::uint64_t moved = 0;
+    std::uint64_t refused = 0;
+    for (std::uint32_t round = 0; round < config.rounds && count > 0; ++round)
+    {
+        for (int k = 0; k < 4; ++k)
+        {
+            const TransformHierarchy::NodeId node = rng.below(count);
+            const TransformHierarchy::NodeId parent = rng.chance(0.1f) ? TransformHierarchy::NoParent : rng.below(count);
+            hierarchy.setParent(node, parent);
+            if (parent != TransformHierarchy::NoParent && reference.isAncestor(node, parent))
+            {
+                ++refused;
+                continue;
+            }
+            reference.parent[node] = parent;
+            ++moved;
+        }
+        for (int k = 0; k < 8; ++k)
+        {
+            const TransformHierarchy::NodeId node = rng.below(count);
+            reference.position[node] = { rng.range(-50.f, 50.f), rng.range(-50.f, 50.f) };
+            reference.rotation[node] = rng.range(-3.f, 3.f);
+            hierarchy.setLocal(node, reference.position[node], reference.rotation[node]);
+        }
+        hierarchy.update();
+
+        for (TransformHierarchy::NodeId node = 0; node < count; ++node)
+        {
+            if (hierarchy.parent(node) != reference.parent[node] || !close(hierarchy.world(node), reference.world(node)))
+            {
+                std::cout << "Transform test: node " << node << " wrong after round " << round << " (parent "
+                          << hierarchy.parent(node) << ", expected " << reference.parent[node] << ")" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::cout << "Transform test: " << config.nodes << " nodes, " << config.rounds << " rounds, " << moved
+              << " reparented, " << refused << " cycles refused, every world transform matches" << std::endl;
+    return 0;
+}
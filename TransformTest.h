@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct TransformTestConfig
+{
+    std::size_t nodes = 256;
+    std::uint32_t rounds = 2000;
+    std::uint64_t seed = 1;
+};
+
+// Builds a random forest on a TransformHierarchy, then each round moves a
+// few nodes under random parents, some of them their own descendants, which
+// must be refused, changes some local transforms and runs update(). After
+// every round each node's parent and world transform are checked against a
+// plain recompute that walks the parent links from the node up, with no
+// ordering at all. Returns 1 on the first mismatch, so scripts can check
+// the result.
+int runTransformTest(const TransformTestConfig& config);
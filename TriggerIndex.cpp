@@ -0,0 +1,51 @@
+#include "TriggerIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+TriggerIndex::TriggerIndex(std::vector<TriggerVolume> triggers) :
+    m_triggers(std::move(triggers)),
+    m_maxRight(m_triggers.size())
+{
+    std::stable_sort(m_triggers.begin(), m_triggers.end(),
+        [](const TriggerVolume& a, const TriggerVolume& b) { return a.left < b.left; });
+    build(0, m_triggers.size());
+}
+
+void TriggerIndex::query(float left, float top, float right, float bottom, std::vector<std::uint32_t>& hits) const
+{
+    query(0, m_triggers.size(), left, top, right, bottom, hits);
+}
+
+float TriggerIndex::build(std::size_t begin, std::size_t end)
+{
+    if (begin >= end)
+        return -std::numeric_limits<float>::infinity();
+
+    const std::size_t middle = begin + (end - begin) / 2;
+    const float maxRight = std::max({ m_triggers[middle].right, build(begin, middle), build(middle + 1, end) });
+    m_maxRight[middle] = maxRight;
+    return maxRight;
+}
+
+void TriggerIndex::query(std::size_t begin, std::size_t end, float left, float top, float right, float bottom,
+                         std::vector<std::uint32_t>& hits) const
+{
+    // The tree is balanced, so the recursion is only log n deep.
+    if (begin >= end)
+        return;
+    const std::size_t middle = begin + (end - begin) / 2;
+    if (m_maxRight[middle] < left)
+        return;             // all of this subtree ends before the box
+
+    query(begin, middle, left, top, right, bottom, hits);
+
+    const TriggerVolume& t = m_triggers[middle];
+    if (t.left > right)
+        return;             // this and everything after it starts past the box
+    if (t.right >= left && t.top <= bottom && t.bottom >= top)
+        hits.push_back(static_cast<std::uint32_t>(middle));
+
+    query(middle + 1, end, left, top, right, bottom, hits);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class TriggerKind : std::uint8_t
+{
+    Pipe,           // Down while inside warps to destination
+    Door,           // Up while inside warps to destination
+    Vine,           // holding Up climbs
+    Checkpoint,     // touching it saves progress
+    Flagpole,       // touching it ends the level
+};
+
+// A region of the level that does something when a player is in it.
+struct TriggerVolume
+{
+    TriggerKind kind;
+    float left, top, right, bottom;     // world coordinates
+    sf::Vector2f destination;           // pipes and doors: where the player comes out
+};
+
+// The level's trigger volumes, built once when the level is loaded and
+// never changed after. Triggers are sorted by left edge and searched as an
+// implicit binary tree. Each node stores the furthest right edge in its
+// subtree, so a query skips every subtree that ends before the box starts,
+// and everything that starts after the box ends. A query visits about
+// log n nodes plus a short path per hit, instead of testing every trigger.
+class TriggerIndex
+{
+public:
+    TriggerIndex() = default;
+    explicit TriggerIndex(std::vector<TriggerVolume> triggers);
+
+    // Appends the index of every trigger overlapping the box to hits.
+    void query(float left, float top, float right, float bottom, std::vector<std::uint32_t>& hits) const;
+
+    std::size_t size() const { return m_triggers.size(); }
+    // In left-edge order, which is what query() indices refer to.
+    const TriggerVolume& operator[](std::size_t index) const { return m_triggers[index]; }
+
+private:
+    float build(std::size_t begin, std::size_t end);
+    void query(std::size_t begin, std::size_t end, float left, float top, float right, float bottom,
+               std::vector<std::uint32_t>& hits) const;
+
+    std::vector<TriggerVolume> m_triggers;
+    std::vector<float> m_maxRight;      // at each subtree's middle index
+};
@@ -0,0 +1,521 @@
+#include "World.h"
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+
+namespace
+{
+    constexpr float WalkSpeed = 180.f;      // pixels per second, doubled while running
+    constexpr float JumpSpeed = 520.f;
+    constexpr float Gravity = 1400.f;       // pixels per second squared
+    constexpr float PlayerSpacing = 40.f;   // where a joining player appears, right of player 0
+    constexpr float StompBounce = 320.f;
+    constexpr float ClimbSpeed = 120.f;
+    constexpr float TwoPi = 6.2831853f;
+
+    bool overlaps(sf::Vector2f aPos, sf::Vector2f aSize, sf::Vector2f bPos, sf::Vector2f bSize)
+    {
+        return aPos.x < bPos.x + bSize.x && bPos.x < aPos.x + aSize.x
+            && aPos.y < bPos.y + bSize.y && bPos.y < aPos.y + aSize.y;
+    }
+}
+
+World::World(sf::Vector2f spawn, float levelWidth, std::uint64_t seed) :
+    m_groundY(spawn.y),
+    m_levelWidth(levelWidth)
+{
+    // put a row boundary exactly on the floor line, so landing snaps to it
+    const float floorY = spawn.y + PlayerSize.y;
+    const auto floorRow = static_cast<std::size_t>(std::max(0.f, std::floor(floorY / TileSize)));
+    m_tiles = TileGrid({ 0.f, floorY - static_cast<float>(floorRow) * TileSize },
+                       static_cast<std::size_t>(std::ceil(levelWidth / TileSize)), floorRow + 2, TileSize);
+    m_tiles.fillFrom(floorRow);
+    m_fired.reserve(MaxTimers);
+
+    for (std::size_t i = 0; i < RandomStreamCount; ++i)
+        m_random[i] = Random(seed, i);
+
+    m_players[0].position = spawn;
+    m_previousPositions[0] = spawn;
+
+    for (TransformHierarchy::NodeId& rider : m_riders)
+        rider = m_transforms.add(TransformHierarchy::NoParent, {});
+}
+
+void World::setPlayerCount(std::size_t count)
+{
+    count = std::clamp<std::size_t>(count, 1, MaxPlayers);
+    for (std::size_t i = m_playerCount; i < count; ++i)
+    {
+        m_players[i] = PlayerState{};
+        m_players[i].position = { m_players[0].position.x + PlayerSpacing * static_cast<float>(i), m_groundY };
+        m_previousPositions[i] = m_players[i].position;
+
+        // a moment's grace, so nobody dies the instant they join
+        m_players[i].invincible = true;
+        m_timers.cancel(m_invincibleTimers[i]);
+        m_invincibleTimers[i] = m_timers.schedule(InvincibleTicks, TimerEvent::InvincibilityEnd,
+                                                  static_cast<std::uint32_t>(i)).value_or(TimerHandle{});
+    }
+    m_playerCount = count;
+}
+
+void World::startLevelTimer(std::uint16_t units)
+{
+    // restarting replaces the running clock rather than adding a second one
+    m_timeLeft = units;
+    m_timers.cancel(m_levelTimer);
+    m_levelTimer = m_timers.schedule(TicksPerTimeUnit, TimerEvent::LevelClock).value_or(TimerHandle{});
+}
+
+void World::giveStarPower(std::size_t player)
+{
+    if (player >= m_playerCount)
+        return;
+    m_players[player].starPower = true;
+    emit(GameEventKind::PowerUp, m_players[player].position + PlayerSize / 2.f);
+    m_timers.cancel(m_starTimers[player]);
+    m_starTimers[player] = m_timers.schedule(StarPowerTicks, TimerEvent::StarPowerEnd,
+                                             static_cast<std::uint32_t>(player)).value_or(TimerHandle{});
+}
+
+void World::spawnEnemy(float x, std::uint8_t type, bool facingRight)
+{
+    m_enemies.spawn(type, x, m_groundY + PlayerSize.y, facingRight);
+}
+
+void World::addPlatforms(const PlatformLayout& layout)
+{
+    // The platforms are children of the pivot, so moving and turning the
+    // pivot carries them all; each turns back the other way to stay level.
+    const TransformHierarchy::NodeId pivot = m_transforms.add(TransformHierarchy::NoParent, layout.pivot);
+    m_rigs.push_back({ layout, pivot, m_platforms.size() });
+    for (std::uint8_t k = 0; k < layout.platforms; ++k)
+    {
+        const float angle = TwoPi * static_cast<float>(k) / static_cast<float>(layout.platforms);
+        const sf::Vector2f offset{ layout.radius * std::cos(angle), layout.radius * std::sin(angle) };
+        m_platforms.push_back({ m_transforms.add(pivot, offset), layout.size });
+    }
+}
+
+std::optional<ProjectileHandle> World::spawnProjectile(ProjectileKind kind, sf::Vector2f position, sf::Vector2f velocity)
+{
+    std::optional<ProjectileHandle> handle = m_projectiles.spawn(kind, position, velocity);
+    if (handle && ProjectileTypes[static_cast<std::size_t>(kind)].fromPlayer)
+        emit(GameEventKind::Fireball, position);
+    return handle;
+}
+
+void World::step(const std::array<InputFrame, MaxPlayers>& inputs)
+{
+    m_defeated.clear();
+    m_thrown.clear();
+    m_triggerEvents.clear();
+    m_events.clear();
+    fireTimers();
+    stepEnemies();
+    stepProjectiles();
+    stepPlatforms();
+
+    for (std::size_t i = 0; i < m_playerCount; ++i)
+    {
+        PlayerState& player = m_players[i];
+        m_previousPositions[i] = player.position;
+        if (!player.alive)
+            continue;
+        // a rider's node is a child of the platform, so stepPlatforms() has already carried it
+        if (player.platform >= 0)
+            player.position = m_transforms.world(m_riders[i]).translation();
+        const bool grounded = player.onGround;
+        stepPlayer(player, inputs[i]);
+        if (grounded && player.velocity.y < 0.f)
+            emit(GameEventKind::Jump, player.position);
+        standOnPlatforms(player, m_previousPositions[i]);
+        resolveContacts(player);
+        if (player.alive)
+            checkTriggers(i, inputs[i]);
+        else
+            emit(GameEventKind::PlayerDied, player.position);
+        updateRider(i);
+    }
+
+    ++m_tick;
+}
+
+StateHashes World::hashState() const
+{
+    StateHashes hashes;
+    hashes.tick = m_tick;
+
+    StateHasher players;
+    players.add(static_cast<std::uint64_t>(m_playerCount));
+    for (std::size_t i = 0; i < m_playerCount; ++i)
+    {
+        const PlayerState& player = m_players[i];
+        players.add(player.position);
+        players.add(player.velocity);
+        players.add(static_cast<std::uint64_t>(player.onGround) | player.facingRight << 1 | player.alive << 2
+                    | player.starPower << 3 | player.invincible << 4);
+        players.add(static_cast<std::uint16_t>(player.platform));
+    }
+    players.add(m_checkpointReached);
+    players.add(m_levelComplete);
+    hashes.players = players.finish();
+
+    StateHasher enemies;
+    m_enemies.hash(enemies);
+    hashes.enemies = enemies.finish();
+
+    StateHasher projectiles;
+    m_projectiles.hash(projectiles);
+    hashes.projectiles = projectiles.finish();
+
+    StateHasher timers;
+    timers.add(m_timeLeft);
+    m_timers.hash(timers);
+    hashes.timers = timers.finish();
+
+    StateHasher random;
+    for (const Random& stream : m_random)
+        for (std::uint64_t word : stream.state())
+            random.add(word);
+    hashes.random = random.finish();
+
+    return hashes;
+}
+
+void World::fireTimers()
+{
+    m_hurryUp = false;
+    m_fired.clear();
+    m_timers.advance(m_fired);
+
+    for (const FiredTimer& timer : m_fired)
+    {
+        switch (timer.event)
+        {
+        case TimerEvent::LevelClock:
+            if (m_timeLeft > 0)
+                --m_timeLeft;
+            m_hurryUp = m_timeLeft == HurryUpTime;
+            if (m_hurryUp)
+                emit(GameEventKind::HurryUp, m_players[0].position);
+            if (m_timeLeft == 0)
+            {
+                for (std::size_t i = 0; i < m_playerCount; ++i)
+                {
+                    if (m_players[i].alive)
+                        emit(GameEventKind::PlayerDied, m_players[i].position);
+                    m_players[i].alive = false;
+                }
+            }
+            else
+                m_levelTimer = m_timers.schedule(TicksPerTimeUnit, TimerEvent::LevelClock).value_or(TimerHandle{});
+            break;
+        case TimerEvent::StarPowerEnd:
+            m_players[timer.subject].starPower = false;
+            break;
+        case TimerEvent::InvincibilityEnd:
+            m_players[timer.subject].invincible = false;
+            break;
+        }
+    }
+}
+
+void World::stepEnemies()
+{
+    // homing enemies and throwers go for the first player still standing
+    sf::Vector2f target = m_players[0].position + PlayerSize / 2.f;
+    for (std::size_t i = 0; i < m_playerCount; ++i)
+    {
+        if (m_players[i].alive)
+        {
+            target = m_players[i].position + PlayerSize / 2.f;
+            break;
+        }
+    }
+    m_enemies.update(TickSeconds, target, m_levelWidth, m_thrown);
+
+    // walkers turn at the level's ends, but flyers keep going and homing
+    // enemies can be carried past them; once wholly outside they're gone
+    for (EnemyArchetype archetype : { EnemyArchetype::Flyer, EnemyArchetype::Homing })
+    {
+        EnemyStore::Batch& batch = m_enemies.batch(archetype);
+        for (std::size_t i = batch.size(); i-- > 0;)
+        {
+            if (batch.x[i] + batch.width[i] < 0.f || batch.x[i] > m_levelWidth)
+                batch.removeSwap(i);
+        }
+    }
+}
+
+void World::stepProjectiles()
+{
+    m_projectiles.update(TickSeconds, m_tiles);
+
+    // this tick's throws start centred on the thrower's hand
+    for (const EnemyThrow& thrown : m_thrown)
+    {
+        const ProjectileKind kind = EnemyTypes[thrown.type].projectile;
+        const sf::Vector2f size = ProjectileTypes[static_cast<std::size_t>(kind)].size;
+        m_projectiles.spawn(kind, thrown.position - size / 2.f, thrown.velocity);
+    }
+
+    // players' projectiles against enemies; each one takes out one enemy
+    for (std::size_t p = 0; p < m_projectiles.size();)
+    {
+        bool hit = false;
+        if (ProjectileTypes[static_cast<std::size_t>(m_projectiles.kind()[p])].fromPlayer)
+        {
+            const sf::Vector2f position{ m_projectiles.x()[p], m_projectiles.y()[p] };
+            const sf::Vector2f size{ m_projectiles.width()[p], m_projectiles.height()[p] };
+            for (std::size_t a = 0; a < EnemyArchetypeCount && !hit; ++a)
+            {
+                EnemyStore::Batch& batch = m_enemies.batch(static_cast<EnemyArchetype>(a));
+                for (std::size_t i = 0; i < batch.size(); ++i)
+                {
+                    if (overlaps(position, size, { batch.x[i], batch.y[i] }, { batch.width[i], batch.height[i] }))
+                    {
+                        emit(GameEventKind::Kick, { batch.x[i], batch.y[i] });
+                        m_defeated.push_back(batch.state(i));
+                        batch.removeSwap(i);
+                        hit = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (hit)
+            m_projectiles.removeAt(p);
+        else
+            ++p;
+    }
+}
+
+void World::resolveContacts(PlayerState& player)
+{
+    for (std::size_t a = 0; a < EnemyArchetypeCount; ++a)
+    {
+        EnemyStore::Batch& batch = m_enemies.batch(static_cast<EnemyArchetype>(a));
+        for (std::size_t i = 0; i < batch.size();)
+        {
+            const sf::Vector2f position{ batch.x[i], batch.y[i] };
+            const sf::Vector2f size{ batch.width[i], batch.height[i] };
+            if (!overlaps(player.position, PlayerSize, position, size))
+            {
+                ++i;
+                continue;
+            }
+
+            // landing on the top half is a stomp, anything else hurts
+            const bool stomp = EnemyTypes[batch.type[i]].stompable && player.velocity.y > 0.f
+                && player.position.y + PlayerSize.y < position.y + size.y / 2.f;
+            if (player.invincible && !stomp)
+            {
+                ++i;
+                continue;
+            }
+            if (!stomp && !player.starPower)
+            {
+                player.alive = false;
+                return;
+            }
+
+            if (stomp)
+            {
+                player.velocity.y = -StompBounce;
+                player.onGround = false;
+            }
+            emit(stomp ? GameEventKind::Stomp : GameEventKind::Kick, position);
+            m_defeated.push_back(batch.state(i));
+            batch.removeSwap(i);
+        }
+    }
+
+    if (player.starPower || player.invincible)
+        return;
+    for (std::size_t p = 0; p < m_projectiles.size(); ++p)
+    {
+        if (ProjectileTypes[static_cast<std::size_t>(m_projectiles.kind()[p])].fromPlayer)
+            continue;
+        if (overlaps(player.position, PlayerSize, { m_projectiles.x()[p], m_projectiles.y()[p] },
+                     { m_projectiles.width()[p], m_projectiles.height()[p] }))
+        {
+            player.alive = false;
+            return;
+        }
+    }
+}
+
+void World::checkTriggers(std::size_t index, const InputFrame& input)
+{
+    // Only players look for triggers, each with one query for its own box.
+    if (!m_triggers)
+        return;
+    PlayerState& player = m_players[index];
+    m_triggerHits.clear();
+    m_triggers->query(player.position.x, player.position.y, player.position.x + PlayerSize.x,
+                      player.position.y + PlayerSize.y, m_triggerHits);
+
+    for (std::uint32_t hit : m_triggerHits)
+    {
+        const TriggerVolume& trigger = (*m_triggers)[hit];
+        bool fired = false;
+        switch (trigger.kind)
+        {
+        case TriggerKind::Pipe:
+        case TriggerKind::Door:
+            fired = input.wasPressed(trigger.kind == TriggerKind::Pipe ? Action::Down : Action::Up);
+            if (fired)
+            {
+                player.position = trigger.destination;
+                player.velocity = {};
+                player.platform = -1;
+                m_previousPositions[index] = player.position;     // no interpolating across the warp
+            }
+            break;
+        case TriggerKind::Vine:
+            fired = input.isDown(Action::Up);
+            if (fired)
+            {
+                player.velocity.y = 0.f;
+                player.position.y -= ClimbSpeed * TickSeconds;
+                player.onGround = false;
+            }
+            break;
+        case TriggerKind::Checkpoint:
+            fired = !m_checkpointReached;
+            m_checkpointReached = true;
+            break;
+        case TriggerKind::Flagpole:
+            fired = !m_levelComplete;
+            m_levelComplete = true;
+            break;
+        }
+        if (fired)
+        {
+            m_triggerEvents.push_back({ static_cast<std::uint8_t>(index), trigger.kind, hit });
+            if (trigger.kind == TriggerKind::Pipe || trigger.kind == TriggerKind::Door)
+                emit(GameEventKind::Pipe, player.position);
+            else if (trigger.kind == TriggerKind::Flagpole)
+                emit(GameEventKind::Flagpole, player.position);
+        }
+        if (fired && (trigger.kind == TriggerKind::Pipe || trigger.kind == TriggerKind::Door))
+            break;      // the hits were for where the player was before the warp
+    }
+}
+
+void World::stepPlayer(PlayerState& player, const InputFrame& input)
+{
+    float direction = 0.f;
+    if (input.isDown(Action::Left))
+        direction -= 1.f;
+    if (input.isDown(Action::Right))
+        direction += 1.f;
+    if (direction != 0.f)
+        player.facingRight = direction > 0.f;
+
+    const float speed = input.isDown(Action::Run) ? WalkSpeed * 2.f : WalkSpeed;
+    player.velocity.x = direction * speed;
+
+    if (player.onGround && input.wasPressed(Action::Jump))
+    {
+        player.velocity.y = -JumpSpeed;
+        player.onGround = false;
+    }
+    if (!player.onGround)
+        player.velocity.y += Gravity * TickSeconds;
+
+    player.position += player.velocity * TickSeconds;
+    if (player.position.y >= m_groundY)
+    {
+        player.position.y = m_groundY;
+        player.velocity.y = 0.f;
+        player.onGround = true;
+    }
+}
+
+void World::stepPlatforms()
+{
+    // Platform motion is a function of the tick alone, so it needs no state
+    // of its own to keep in sync.
+    const float t = static_cast<float>(m_tick + 1) * TickSeconds;
+    for (const PlatformRig& rig : m_rigs)
+    {
+        const PlatformLayout& layout = rig.layout;
+        const float swing = layout.swingSeconds > 0.f ? std::sin(TwoPi * t / layout.swingSeconds) : 0.f;
+        const float rotation = layout.spin * t;
+        m_transforms.setLocal(rig.pivot, layout.pivot + layout.swing * swing, rotation);
+        for (std::size_t k = 0; k < layout.platforms; ++k)
+        {
+            const TransformHierarchy::NodeId node = m_platforms[rig.firstPlatform + k].node;
+            m_transforms.setLocal(node, m_transforms.localPosition(node), -rotation);
+        }
+    }
+    m_transforms.update();
+}
+
+void World::updateRider(std::size_t index)
+{
+    const PlayerState& player = m_players[index];
+    const TransformHierarchy::NodeId rider = m_riders[index];
+    if (player.platform < 0)
+    {
+        if (m_transforms.parent(rider) != TransformHierarchy::NoParent)
+            m_transforms.setParent(rider, TransformHierarchy::NoParent);
+        return;
+    }
+
+    // platforms stay level, so the offset from the centre is the local position
+    const Platform& platform = m_platforms[static_cast<std::size_t>(player.platform)];
+    if (m_transforms.parent(rider) != platform.node)
+        m_transforms.setParent(rider, platform.node);
+    m_transforms.setLocal(rider, player.position - m_transforms.world(platform.node).translation());
+}
+
+void World::standOnPlatforms(PlayerState& player, sf::Vector2f previousPosition)
+{
+    auto under = [&player](const Platform& platform, sf::Vector2f centre)
+    {
+        return player.position.x < centre.x + platform.size.x / 2.f
+            && player.position.x + PlayerSize.x > centre.x - platform.size.x / 2.f;
+    };
+
+    if (player.platform >= 0)
+    {
+        // stepPlayer already carried on standing, unless the player jumped
+        const Platform& platform = m_platforms[static_cast<std::size_t>(player.platform)];
+        const sf::Vector2f centre = m_transforms.world(platform.node).translation();
+        if (player.onGround && under(platform, centre))
+        {
+            player.position.y = centre.y - platform.size.y / 2.f - PlayerSize.y;
+            return;
+        }
+        player.platform = -1;
+        player.onGround = player.position.y >= m_groundY;
+        return;
+    }
+
+    // Land only from above: the feet were over the platform's top last tick
+    // and are at or under it now.
+    if (player.velocity.y < 0.f || player.position.y >= m_groundY)
+        return;
+    const float feet = player.position.y + PlayerSize.y;
+    const float previousFeet = previousPosition.y + PlayerSize.y;
+    for (std::size_t i = 0; i < m_platforms.size(); ++i)
+    {
+        const Platform& platform = m_platforms[i];
+        const sf::Vector2f centre = m_transforms.world(platform.node).translation();
+        const float top = centre.y - platform.size.y / 2.f;
+        const float previousTop = m_transforms.previous(platform.node).translation().y - platform.size.y / 2.f;
+        if (previousFeet <= previousTop && feet >= top && under(platform, centre))
+        {
+            player.position.y = top - PlayerSize.y;
+            player.velocity.y = 0.f;
+            player.onGround = true;
+            player.platform = static_cast<std::int16_t>(i);
+            return;
+        }
+    }
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "EnemyStore.h"
+#include "InputFrame.h"
+#include "ProjectilePool.h"
+#include "Random.h"
+#include "StateHash.h"
+#include "TileGrid.h"
+#include "TimerWheel.h"
+#include "TransformHierarchy.h"
+#include "TriggerIndex.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+// The simulation runs at a fixed rate no matter how fast the display refreshes.
+constexpr int TickRate = 60;
+constexpr float TickSeconds = 1.f / TickRate;
+
+constexpr std::size_t MaxPlayers = 2;      // Mario and Luigi
+
+// Per world. Enough for a screen full of hammers; past it, throws fizzle.
+constexpr std::size_t MaxProjectiles = 256;
+constexpr float TileSize = 32.f;
+
+// Per world: the level clock, power-ups and the like.
+constexpr std::size_t MaxTimers = 64;
+
+// The level timer counts down in units of 24 ticks, as in the original.
+constexpr std::uint32_t TicksPerTimeUnit = 24;
+constexpr std::uint16_t HurryUpTime = 100;
+constexpr std::uint32_t StarPowerTicks = 10 * TickRate;
+constexpr std::uint32_t InvincibleTicks = 2 * TickRate;
+
+// A player set off a trigger during the last step().
+struct TriggerEvent
+{
+    std::uint8_t player;
+    TriggerKind kind;
+    std::uint32_t trigger;      // index into the world's TriggerIndex
+};
+
+// Something happened during the last step() that players should see or hear.
+// The simulation only records these; see EventBus for who hears about them.
+enum class GameEventKind : std::uint8_t
+{
+    Jump,
+    Stomp,          // an enemy stomped
+    Kick,           // an enemy knocked out by a fireball or star power
+    PowerUp,
+    Fireball,       // a player threw one
+    Pipe,           // went down a pipe or through a door
+    Flagpole,
+    HurryUp,
+    PlayerDied,
+    Count
+};
+constexpr std::size_t GameEventKindCount = static_cast<std::size_t>(GameEventKind::Count);
+
+struct GameEvent
+{
+    GameEventKind kind;
+    sf::Vector2f position;      // where, in world coordinates
+};
+
+// A set of moving platforms sharing one pivot. The pivot swings back and
+// forth and spins; the platforms sit evenly spaced around it at radius and
+// stay level. One platform at radius 0 is a plain lift.
+struct PlatformLayout
+{
+    sf::Vector2f pivot;
+    sf::Vector2f swing;             // furthest the pivot moves each way
+    float swingSeconds;             // for a full back-and-forth; 0 holds still
+    float spin;                     // radians per second
+    float radius;
+    std::uint8_t platforms;
+    sf::Vector2f size;
+};
+
+// One platform of a PlatformLayout. node is its centre in the world's
+// TransformHierarchy.
+struct Platform
+{
+    TransformHierarchy::NodeId node;
+    sf::Vector2f size;
+};
+
+// Collision box, with position as the top-left corner. Enemy sizes are in EnemyTypes.
+constexpr sf::Vector2f PlayerSize{ 39.f, 44.f };
+
+struct PlayerState
+{
+    sf::Vector2f position;
+    sf::Vector2f velocity;
+    bool onGround = true;
+    bool facingRight = true;
+    bool alive = true;          // cleared when an enemy walks into the player
+    bool starPower = false;     // enemies touched are defeated
+    bool invincible = false;    // enemies and projectiles pass through harmlessly
+    std::int16_t platform = -1; // index of the platform being ridden, if any
+};
+
+// Gameplay state advanced one fixed tick at a time. Knows nothing about
+// rendering, so the same code can run headless.
+class World
+{
+public:
+    // Everything random in the world comes from seed, so the same seed and
+    // inputs replay exactly.
+    World(sf::Vector2f spawn, float levelWidth, std::uint64_t seed = 1);
+
+    // Player 0 always exists. Joining puts the new player next to player 0.
+    void setPlayerCount(std::size_t count);
+    std::size_t playerCount() const { return m_playerCount; }
+
+    // One input frame per player slot; slots past playerCount() are ignored.
+    void step(const std::array<InputFrame, MaxPlayers>& inputs);
+
+    // Enemies stand on the same ground as the players, flyers above it.
+    // type indexes EnemyTypes.
+    void spawnEnemy(float x, std::uint8_t type, bool facingRight = false);
+    const EnemyStore& enemies() const { return m_enemies; }
+
+    // Enemies stomped during the last step(), e.g. for battle mode to pass on.
+    const std::vector<EnemyState>& defeatedThisTick() const { return m_defeated; }
+
+    // Hammers, spinies and the like thrown during the last step().
+    const std::vector<EnemyThrow>& thrownThisTick() const { return m_thrown; }
+
+    // Fireballs and the like; enemies' throws turn into projectiles on their own.
+    // Nothing if the world already has MaxProjectiles in flight.
+    std::optional<ProjectileHandle> spawnProjectile(ProjectileKind kind, sf::Vector2f position, sf::Vector2f velocity);
+    const ProjectilePool& projectiles() const { return m_projectiles; }
+
+    // Solid ground, the floor the players stand on and everything under it.
+    const TileGrid& tiles() const { return m_tiles; }
+
+    // Starts the level timer at units, or restarts it; when it runs out,
+    // every player dies. Levels only, battle mode has no time limit.
+    void startLevelTimer(std::uint16_t units);
+    std::uint16_t timeLeft() const { return m_timeLeft; }
+    // True on the tick the timer drops to HurryUpTime.
+    bool hurryUpThisTick() const { return m_hurryUp; }
+
+    const TimerWheel& timers() const { return m_timers; }
+
+    // Moving platforms. Players standing on one are carried along with it.
+    void addPlatforms(const PlatformLayout& layout);
+    const std::vector<Platform>& platforms() const { return m_platforms; }
+    const TransformHierarchy& transforms() const { return m_transforms; }
+
+    // The level's triggers. Shared, not copied, since they never change,
+    // so snapshots of the world stay cheap.
+    void setTriggers(std::shared_ptr<const TriggerIndex> triggers) { m_triggers = std::move(triggers); }
+    const std::vector<TriggerEvent>& triggeredThisTick() const { return m_triggerEvents; }
+    bool checkpointReached() const { return m_checkpointReached; }
+    bool levelComplete() const { return m_levelComplete; }
+
+    // A second star restarts the countdown rather than adding to it.
+    void giveStarPower(std::size_t player);
+
+    // Everything players should see or hear from the last step(), in the
+    // order it happened. Always empty in the headless build.
+    const std::vector<GameEvent>& eventsThisTick() const { return m_events; }
+
+    std::uint32_t tick() const { return m_tick; }
+
+    // Gameplay code draws from its subsystem's stream, never from std::rand.
+    Random& random(RandomStream stream) { return m_random[static_cast<std::size_t>(stream)]; }
+    const Random& random(RandomStream stream) const { return m_random[static_cast<std::size_t>(stream)]; }
+
+    // Hashes of everything step() depends on, for spotting desyncs.
+    StateHashes hashState() const;
+    const PlayerState& player(std::size_t index = 0) const { return m_players[index]; }
+
+    // Where a player was one tick ago, for render interpolation.
+    sf::Vector2f previousPlayerPosition(std::size_t index = 0) const { return m_previousPositions[index]; }
+
+private:
+    void stepPlayer(PlayerState& player, const InputFrame& input);
+    void stepEnemies();
+    void stepProjectiles();
+    void fireTimers();
+    void resolveContacts(PlayerState& player);
+    void checkTriggers(std::size_t index, const InputFrame& input);
+    void stepPlatforms();
+    void standOnPlatforms(PlayerState& player, sf::Vector2f previousPosition);
+    // Makes player index's node a child of the platform it stands on, or
+    // of nothing, and records where on the platform it stands.
+    void updateRider(std::size_t index);
+
+    // Nobody on a server watches or listens, so it records nothing there.
+    void emit(GameEventKind kind, sf::Vector2f position)
+    {
+#ifndef SUPERMARIO_HEADLESS
+        m_events.push_back({ kind, position });
+#else
+        (void)kind, (void)position;
+#endif
+    }
+
+    std::uint32_t m_tick = 0;
+    float m_groundY;
+    float m_levelWidth;
+    std::size_t m_playerCount = 1;
+    std::array<PlayerState, MaxPlayers> m_players{};
+    std::array<sf::Vector2f, MaxPlayers> m_previousPositions{};
+    EnemyStore m_enemies;
+    std::vector<EnemyState> m_defeated;
+    std::vector<EnemyThrow> m_thrown;
+    TileGrid m_tiles;
+    ProjectilePool m_projectiles{ MaxProjectiles };
+    TimerWheel m_timers{ MaxTimers };
+    std::vector<FiredTimer> m_fired;
+    TimerHandle m_levelTimer{};
+    std::array<TimerHandle, MaxPlayers> m_starTimers{};
+    std::array<TimerHandle, MaxPlayers> m_invincibleTimers{};
+    std::uint16_t m_timeLeft = 0;
+    bool m_hurryUp = false;
+    std::shared_ptr<const TriggerIndex> m_triggers;
+    std::vector<std::uint32_t> m_triggerHits;       // scratch for queries
+    std::vector<TriggerEvent> m_triggerEvents;
+    bool m_checkpointReached = false;
+    bool m_levelComplete = false;
+    std::vector<GameEvent> m_events;
+
+    struct PlatformRig
+    {
+        PlatformLayout layout;
+        TransformHierarchy::NodeId pivot;
+        std::size_t firstPlatform;
+    };
+    TransformHierarchy m_transforms;
+    std::vector<PlatformRig> m_rigs;
+    std::vector<Platform> m_platforms;
+    std::array<TransformHierarchy::NodeId, MaxPlayers> m_riders{};    // one node per player slot
+    std::array<Random, RandomStreamCount> m_random;
+};
+
+// Blend between the last two ticks; alpha is how far into the next tick we are.
+inline sf::Vector2f interpolate(sf::Vector2f previous, sf::Vector2f current, float alpha)
+{
+    return previous + (current - previous) * alpha;
+}
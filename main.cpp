@@ -1,11 +1,47 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include <algorithm>
+#include <array>
 #include <iostream>
-int main()
+#include <memory>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include "AssetIds.h"
+#include "DebugOverlay.h"
+#include "EventBus.h"
+#include "FramePacer.h"
+#include "IdleController.h"
+#include "ImageBenchmark.h"
+#include "ImageCache.h"
+#include "ImageLoader.h"
+#include "Input.h"
+#include "Letterbox.h"
+#include "Levels.h"
+#include "PagedBackground.h"
+#include "ParticleSystem.h"
+#include "Profiler.h"
+#include "QualityGovernor.h"
+#include "SceneBatch.h"
+#include "SceneTarget.h"
+#include "SoundAssets.h"
+#include "SoundBoard.h"
+#include "ThreadPool.h"
+#include "World.h"
+int main(int argc, char* argv[])
 {
+    // the asset step; the build runs it after linking, and it skips clips already done
+    if (argc > 1 && std::string(argv[1]) == "--transcode-sounds")
+        return transcodeLongSounds("assets/mario sounds");
+    if (argc > 1 && std::string(argv[1]) == "--image-bench")
+        return runImageBenchmark({});
+    sf::Clock startupClock;     // to the first frame on screen
+
     // Create the game window (200x200 size with title "SFML works!")
     sf::RenderWindow window(sf::VideoMode({ 1080, 480 }), "Super mario");       // setting game resolution.
+    window.setVerticalSyncEnabled(true);        // render at the display's rate, the simulation has its own fixed tick
 
     // Create a circle shape with radius 100 pixels
     //sf::CircleShape shape(100.f);
@@ -15,26 +51,44 @@ int main()
     //    music.play();   // playing the background music
     
 
-    // load background image
-    sf::Texture backgroundimg;
-    if (!backgroundimg.loadFromFile("assets/mariobackground.png")) {
-        std::cerr << "Error: Failed to load background texture!" << std::endl;
-        return -1;
-    }
+    // Images come from decoded copies in cache/ when they are up to date,
+    // so only the first launch after a change pays for decoding. The ones
+    // that do need decoding are decoded side by side on the worker threads.
+    ImageCache imageCache;
+    ThreadPool workers;
+    ImageLoader imageLoader(imageCache, workers);
+    const std::size_t uploadBytesPerFrame = 4 * 1024 * 1024;
 
     sf::Texture mariotexture;
-    if (!mariotexture.loadFromFile("assets/mario.png")) {
-        std::cerr << "Error: Failed to load mariocharcter texture!" << std::endl;
+    sf::Texture luigitexture;       // player 2 in split screen
+    imageLoader.add(mariotexture, asset(AssetId::MarioPng).path);
+    imageLoader.add(luigitexture, asset(AssetId::MarioSpritesInLevbelSmasSmb3SuperLuigiSpritePng).path);
+    if (!imageLoader.prepare()) {
+        std::cerr << "Error: Failed to load textures!" << std::endl;
         return -1;
     }
+    // Mario is on the first frame; Luigi isn't needed until F2, so he goes up
+    // over the next frames
+    while (!imageLoader.uploaded(mariotexture))
+        imageLoader.upload(uploadBytesPerFrame);
     //mariotexture.loadFromFile("assets/mario.png");
 
+    // logical play area; the window may be any size, the letterbox scales this to fit
+    const sf::Vector2f playArea(1080.f, 480.f);
+
+    // load background image. It is far wider than the screen, so it is kept
+    // in pages and only the ones around the cameras are on the GPU; every
+    // view (one, or two in split screen) draws from the same page cache.
+    // setting the scale of background image to fit the window.
+    PagedBackground background({ 0.f, 0.f }, { 1.f, 2.f });
+    if (!background.open(workers, asset(AssetId::MariobackgroundPng).path, playArea, MaxPlayers)) {
+        std::cerr << "Error: Failed to load background texture!" << std::endl;
+        return -1;
+    }
+
     // making background sprite.
-    sf::Sprite backgroundSprite(backgroundimg);
     //sf::View gameView(sf::Vector2f(3376 / 2.f, 480 / 2.f), sf::Vector2f(3376.f, 480.f));
     //backgroundSprite.setOrigin({0.f,backgroundimg.getSize().y - 240.f});
-	backgroundSprite.setScale({ 1.f,2.f });     // setting the scale of background image to fit the window.
-	backgroundSprite.setPosition({ 0.f,backgroundimg.getSize().y - 480.f });      // setting the position of background image to fit the window.
     // setting center of background.
         // 1. Get the size of the texture
         //  sf::Vector2u textureSize = backgroundimg.getSize();
@@ -49,42 +103,299 @@ int main()
           //backgroundSprite.setPosition(windowCenter);
 
     sf::Sprite mariosprite(mariotexture);
-    mariosprite.setPosition({ 10.f , backgroundimg.getSize().y - 44.f - 65.f});
+    mariosprite.setPosition({ 10.f , background.imageSize().y - 44.f - 65.f});
 
     // Set the fill color of the circle to green
     //shape.setFillColor(sf::Color::Green);
 
+    std::array<InputSystem, MaxPlayers> inputs{ InputSystem(0), InputSystem(1) };
+    Profiler profiler;
+    const std::size_t frameSeries = profiler.track("frame ms");
+
+    sf::Font uiFont;
+    DebugOverlay overlay;       // F3 shows the profiler numbers
+    const bool haveUiFont = uiFont.openFromFile(asset(AssetId::ArialTtf).path);
+    if (haveUiFont)
+        overlay.setFont(uiFont);
+    else
+        std::cerr << "Warning: Failed to load ui font, debug overlay disabled" << std::endl;
+
+    // pause screen: the game underneath is frozen, only the label blinks
+    sf::RectangleShape pauseShade;
+    pauseShade.setFillColor(sf::Color(0, 0, 0, 140));
+    std::optional<sf::Text> pauseLabel;
+    if (haveUiFont)
+        pauseLabel.emplace(uiFont, "PAUSED", 48);
+    const sf::Time pauseBlink = sf::milliseconds(500);
+    sf::Clock pauseClock;
+
+    Letterbox letterbox(playArea);
+
+    // Drops internal resolution (and effects) when frames run late. Render side only.
+    QualityGovernor governor;
+    SceneTarget sceneTarget;
+
+    IdleController idle;        // lets static screens sleep instead of redrawing
+    bool paused = false;
+
+    // Every view culls and batches from the same sprite list. The first
+    // camera's pages are loaded up front; the rest stream in as it moves.
+    background.load(sf::FloatRect(background.bounds().position, playArea));
+    SpriteList sprites;
+    std::array<ViewRenderList, MaxPlayers> viewLists;
+    std::array<std::size_t, MaxPlayers> viewSeries{ profiler.track("view 1 ms"), profiler.track("view 2 ms") };
+    bool splitScreen = false;   // F2
+
+    // Gameplay runs at a fixed 60 Hz; frames in between show Mario interpolated
+    // between the last two ticks, so 120/144 Hz displays stay smooth and the
+    // game speed never depends on the refresh rate.
+    World world(mariosprite.getPosition(), background.bounds().size.x);
+    world.startLevelTimer(400);
+    world.setTriggers(std::make_shared<const TriggerIndex>(
+        std::vector<TriggerVolume>(Level1_1Triggers.begin(), Level1_1Triggers.end())));
+    for (const PlatformLayout& layout : Level1_1Platforms)
+        world.addPlatforms(layout);
+
+    // The world reports what happened each tick; sounds play on the sound
+    // board's thread and particles on the render side, both fed by the bus.
+    EventBus events;
+    SoundBoard soundBoard(events.audio());
+    const std::size_t mixSeries = profiler.track("mix us/block");
+    const std::size_t voiceSeries = profiler.track("voices");
+    {
+        std::ostringstream memory;
+        memory.precision(2);
+        memory << std::fixed << "audio " << soundBoard.residentBytes() / (1024.0 * 1024.0) << " MB resident ("
+               << soundBoard.decodedBytes() / (1024.0 * 1024.0) << " MB decoded)";
+        profiler.note(memory.str());
+
+        const sf::Vector2u atlas = background.texture().getSize();
+        const sf::Vector2u image = background.imageSize();
+        std::ostringstream pages;
+        pages.precision(2);
+        pages << std::fixed << "background " << background.slotCount() << " of " << background.pageCount() << " pages resident, "
+              << atlas.x * atlas.y * 4 / (1024.0 * 1024.0) << " MB (whole image " << image.x * image.y * 4 / (1024.0 * 1024.0) << " MB)";
+        profiler.note(pages.str());
+    }
+    const std::size_t pageSeries = profiler.track("bg pages");
+    ParticleSystem particles;
+    FramePacer pacer;
+    const float maxFrameTime = 0.25f;   // after a hitch, drop time rather than spiral into catch-up ticks
+    float accumulator = 0.f;
+    sf::Clock frameClock;
+    // Input waiting for the next tick. Frames that run no tick (most of them
+    // above 60 Hz) add their edges here instead of dropping them.
+    std::array<InputFrame, MaxPlayers> frames{};
+
     // Main game loop - runs until window is closed
     while (window.isOpen())
     {
-        // Handle events (like pressing close button)
-        while (auto event = window.pollEvent())
+        // Handle events (like pressing close button). On a static screen the
+        // first call sleeps until there is something to do.
+        for (auto event = idle.nextEvent(window); event; event = window.pollEvent())
         {
             // If close event triggered
             if (event->is<sf::Event::Closed>())
                 window.close();
 
-            // Handle window resizing to keep the background centered
-            if (const auto* resized = event->getIf<sf::Event::Resized>()) {
-                sf::FloatRect visibleArea({ 0.f, 0.f }, sf::Vector2f(resized->size));
-                window.setView(sf::View(visibleArea));
+            idle.handleEvent(*event);
+            for (InputSystem& input : inputs)
+                input.handleEvent(*event);
+            if (event->is<sf::Event::FocusLost>())
+                paused = true;          // never keep playing behind the player's back
+            if (const auto* key = event->getIf<sf::Event::KeyPressed>(); key && key->scancode == sf::Keyboard::Scancode::F3)
+                overlay.toggle();
+            if (const auto* key = event->getIf<sf::Event::KeyPressed>(); key && key->scancode == sf::Keyboard::Scancode::F2)
+            {
+                // Luigi joins (or leaves); the keyboard gets split between the two
+                splitScreen = !splitScreen;
+                world.setPlayerCount(splitScreen ? 2 : 1);
+                frames[1] = InputFrame{};     // nothing left over from the last time Luigi played
+                inputs[0].setKeyboardShared(splitScreen);
+            }
+
+            // Handle window resizing. Only remember the size here, dragging an
+            // edge sends many of these per frame and the view is rebuilt once below.
+            if (const auto* resized = event->getIf<sf::Event::Resized>())
+                letterbox.requestResize(resized->size);
+        }
+
+        if (!window.isOpen())
+            break;
+
+        // The letterbox keeps the whole scene in logical coordinates, so the
+        // background and Mario never need repositioning after a resize.
+        letterbox.apply(window);
+
+        // Sample input as late as possible, right before it is used, so a press
+        // that arrived while we were pumping events still makes this frame.
+        sf::Clock workClock;
+        const float frameTime = frameClock.restart().asSeconds();
+        bool pausePressed = false;
+        for (std::size_t i = 0; i < world.playerCount(); ++i)
+        {
+            const InputFrame sampled = inputs[i].sample(window.hasFocus());
+            frames[i].down = sampled.down;
+            frames[i].pressed |= sampled.pressed;
+            frames[i].released |= sampled.released;
+            pausePressed = pausePressed || sampled.wasPressed(Action::Pause);
+        }
 
-                // Re-center the background on resize
-                sf::Vector2u currentWindowSize = window.getSize();
-                sf::Vector2f newWindowCenter(static_cast<float>(currentWindowSize.x) / 2.f, static_cast<float>(currentWindowSize.y) / 3.f);
-                backgroundSprite.setPosition(newWindowCenter);
+        bool resumed = false;
+        if (pausePressed)
+        {
+            paused = !paused;
+            resumed = !paused;
+            pauseClock.restart();
+        }
+        idle.setStatic(paused);
+        if (paused)
+        {
+            // presses on the pause screen don't carry over into the game
+            for (InputFrame& frame : frames)
+            {
+                frame.pressed = 0;
+                frame.released = 0;
+            }
+        }
+
+        if (!paused)
+        {
+            // time spent on the pause screen doesn't count towards the next tick
+            if (!resumed)
+                accumulator += std::min(frameTime, maxFrameTime);
+            while (accumulator >= TickSeconds)
+            {
+                world.step(frames);
+                events.publish(world.eventsThisTick());
+                accumulator -= TickSeconds;
+                // the edges belong to the first tick only, later ticks just see held buttons
+                for (InputFrame& frame : frames)
+                {
+                    frame.pressed = 0;
+                    frame.released = 0;
+                }
             }
         }
 
+        // effects for whatever ticks just ran, thinned out when frames run late
+        const float density = governor.settings().particleDensity;
+        events.effects().drain([&](const GameEvent& event) { particles.spawn(event, density); });
+        if (!paused)
+            particles.update(std::min(frameTime, maxFrameTime));
+
+        // whatever images are still on their way to the GPU, a few strips a frame
+        imageLoader.upload(uploadBytesPerFrame);
+        background.update(uploadBytesPerFrame);
+
+        // Nothing changed on a static screen, or nobody can see it: skip the frame.
+        if (!idle.shouldRender())
+            continue;
+
         // Clear the window from last frame
         window.clear();
        
+        sf::RenderTarget& scene = sceneTarget.begin(window, letterbox, governor.settings().renderScale);
+        const float alpha = paused ? 1.f : accumulator / TickSeconds;
+
+        // one sprite list for the frame, shared by every view
+        sprites.clear();
+        const sf::Vector2f marioSize(mariotexture.getSize());
+        std::array<sf::FloatRect, MaxPlayers> playerBounds{};
+        for (std::size_t i = 0; i < world.playerCount(); ++i)
+        {
+            const sf::Texture& texture = i == 0 ? mariotexture : luigitexture;
+            const sf::Vector2f textureSize(texture.getSize());
+            const sf::Vector2f size(textureSize.x * marioSize.y / textureSize.y, marioSize.y);     // same height as Mario
+            playerBounds[i] = sf::FloatRect(interpolate(world.previousPlayerPosition(i), world.player(i).position, alpha), size);
+            sprites.add(texture, playerBounds[i], sf::IntRect({ 0, 0 }, sf::Vector2i(texture.getSize())),
+                        !world.player(i).facingRight);
+        }
 
         // Draw the green circle shape
-        window.draw(backgroundSprite);
-        window.draw(mariosprite);
+        const std::size_t viewCount = splitScreen ? 2 : 1;
+        const sf::Vector2f viewSize(letterbox.logicalSize().x / static_cast<float>(viewCount), letterbox.logicalSize().y);
+        std::array<sf::FloatRect, MaxPlayers> listenerViews{};
+        for (std::size_t i = 0; i < viewCount; ++i)
+        {
+            sf::Clock viewClock;
+
+            // each camera follows its player, without looking past the ends of the level
+            const sf::FloatRect level = background.bounds();
+            const float playerCenter = playerBounds[i].getCenter().x;
+            const float cameraX = std::clamp(playerCenter, level.position.x + viewSize.x / 2.f,
+                                             std::max(level.position.x + viewSize.x / 2.f, level.position.x + level.size.x - viewSize.x / 2.f));
+            sf::View camera({ cameraX, viewSize.y / 2.f }, viewSize);
+            listenerViews[i] = sf::FloatRect({ cameraX - viewSize.x / 2.f, 0.f }, viewSize);
+            camera.setViewport(sceneTarget.mapViewport(
+                sf::FloatRect({ static_cast<float>(i) / static_cast<float>(viewCount), 0.f }, { 1.f / static_cast<float>(viewCount), 1.f }),
+                letterbox));
+
+            viewLists[i].build(camera, background, sprites);
+            viewLists[i].buildProjectiles(world.projectiles(), (1.f - alpha) * TickSeconds);
+            viewLists[i].appendPlatforms(world.transforms(), world.platforms(), alpha);
+            viewLists[i].appendParticles(particles);
+            viewLists[i].draw(scene, background);
+            profiler.record(viewSeries[i], viewClock.getElapsedTime().asSeconds() * 1000.f);
+        }
+        sceneTarget.end(window, letterbox);
+        if (background.waitingCells() > 0)
+            idle.invalidate();      // draw again once the missing pages are in
+        soundBoard.setListeners(std::span(listenerViews.data(), viewCount));    // sounds are heard from the cameras
+
+        // ui goes straight to the window at full resolution
+        if (paused)
+        {
+            pauseShade.setSize(window.getView().getSize());
+            pauseShade.setPosition(window.getView().getCenter() - window.getView().getSize() / 2.f);
+            window.draw(pauseShade);
+
+            // blink the label and wake up again exactly when it next changes
+            const sf::Time elapsed = pauseClock.getElapsedTime();
+            if (pauseLabel && (elapsed.asMilliseconds() / pauseBlink.asMilliseconds()) % 2 == 0)
+            {
+                pauseLabel->setPosition(window.getView().getCenter() - pauseLabel->getGlobalBounds().size / 2.f);
+                window.draw(*pauseLabel);
+            }
+            idle.scheduleRedraw(pauseBlink - sf::milliseconds(elapsed.asMilliseconds() % pauseBlink.asMilliseconds()));
+        }
+        if (overlay.isVisible())
+        {
+            std::ostringstream stats;
+            profiler.report(stats);
+            pacer.report(stats);
+            overlay.draw(window, stats.str());
+        }
+        const float cpuTime = workClock.getElapsedTime().asSeconds();
         // Display whats drawn on the screen
         window.display();
+        idle.markRendered();
+        if (startupClock.isRunning())
+        {
+            const ImageCache::Stats images = imageCache.stats();
+            std::ostringstream startup;
+            startup << "first frame " << startupClock.getElapsedTime().asMilliseconds() << " ms, images "
+                    << images.hits << " cached, " << images.misses + images.stale << " decoded";
+            profiler.note(startup.str());
+            startupClock.stop();
+        }
+        for (InputSystem& input : inputs)
+            input.markPresented(profiler);
+        if (!paused)
+        {
+            pacer.presented(profiler);
+            profiler.record(frameSeries, frameTime * 1000.f);
+            profiler.record(mixSeries, static_cast<float>(soundBoard.mixer().lastBlockMicroseconds()));
+            profiler.record(voiceSeries, static_cast<float>(soundBoard.mixer().lastBlockVoices()));
+            profiler.record(pageSeries, static_cast<float>(background.residentPages()));
+            // without vsync the "refresh period" is just our own frame time, don't chase it
+            governor.setTarget(std::max(pacer.refreshPeriodMs(), 1000.f / 240.f));
+            // the frame after the pause screen spans the whole pause, like the accumulator ignores it
+            if (!resumed)
+                governor.update(cpuTime * 1000.f, frameTime * 1000.f, profiler);
+        }
+        else
+            pacer.reset();      // sleeping on the pause screen is not a missed frame
     }
 
     return 0;